@@ -1,5 +1,6 @@
 #include "lamda_wrapper.h"
 #include "luau_bridge.h"
+#include "luau_engine.h"
 
 #include <godot_cpp/variant/utility_functions.hpp>
 
@@ -33,7 +34,15 @@ Variant LuaFunctionWrapper::invoke(const Variant** p_args, GDExtensionInt p_arg_
     }
 
     // Call the function with p_arg_count arguments and 1 expected result
+    LuauEngine *engine = LuauEngine::get_singleton();
+    LuauEngine::VMType vm_type = engine ? LuauEngine::get_vm_type(L) : LuauEngine::VM_MAX;
+    if (vm_type != LuauEngine::VM_MAX) {
+        engine->begin_call(vm_type);
+    }
     int status = lua_pcall(L, static_cast<int>(p_arg_count), 1, 0);
+    if (vm_type != LuauEngine::VM_MAX) {
+        engine->end_call(vm_type);
+    }
     
     if (status != LUA_OK) {
         const char* err = lua_tostring(L, -1);
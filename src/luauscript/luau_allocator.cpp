@@ -0,0 +1,127 @@
+#include "luau_allocator.h"
+
+#include <godot_cpp/core/memory.hpp>
+
+#include <cstring>
+
+using namespace godot;
+
+void *LuauAllocator::alloc_small(size_t p_class) {
+    FreeBlock *block = free_lists[p_class];
+    if (block) {
+        free_lists[p_class] = block->next;
+        return block;
+    }
+
+    size_t block_size = (p_class + 1) * SIZE_CLASS_STEP;
+    if (chunk_cursor + block_size > chunk_end) {
+        // The unused tail of the previous chunk is abandoned; it is at most MAX_SMALL_SIZE bytes.
+        uint8_t *chunk = (uint8_t *)memalloc(CHUNK_SIZE);
+        if (!chunk) {
+            return nullptr;
+        }
+
+        chunks.push_back(chunk);
+        chunk_cursor = chunk;
+        chunk_end = chunk + CHUNK_SIZE;
+    }
+
+    void *ptr = chunk_cursor;
+    chunk_cursor += block_size;
+    return ptr;
+}
+
+void LuauAllocator::free_small(void *p_ptr, size_t p_class) {
+    FreeBlock *block = (FreeBlock *)p_ptr;
+    block->next = free_lists[p_class];
+    free_lists[p_class] = block;
+}
+
+void *LuauAllocator::allocate(size_t p_size) {
+    void *ptr = p_size <= MAX_SMALL_SIZE ? alloc_small(size_class(p_size)) : memalloc(p_size);
+    if (!ptr) {
+        return nullptr;
+    }
+
+    stats.allocations++;
+    stats.live_bytes += p_size;
+    if (stats.live_bytes > stats.peak_bytes) {
+        stats.peak_bytes = stats.live_bytes;
+    }
+
+    return ptr;
+}
+
+void LuauAllocator::deallocate(void *p_ptr, size_t p_size) {
+    if (p_size <= MAX_SMALL_SIZE) {
+        free_small(p_ptr, size_class(p_size));
+    } else {
+        memfree(p_ptr);
+    }
+
+    stats.frees++;
+    stats.live_bytes -= p_size;
+}
+
+void *LuauAllocator::reallocate(void *p_ptr, size_t p_osize, size_t p_nsize) {
+    // Luau always reports the real old size, so blocks carry no header.
+    size_t old_size = p_ptr ? p_osize : 0;
+    if (limit_bytes && protected_depth && p_nsize > old_size && stats.live_bytes - old_size + p_nsize > limit_bytes) {
+        return nullptr;
+    }
+
+    if (!p_ptr) {
+        return p_nsize == 0 ? nullptr : allocate(p_nsize);
+    }
+
+    if (p_nsize == 0) {
+        deallocate(p_ptr, p_osize);
+        return nullptr;
+    }
+
+    bool old_small = p_osize <= MAX_SMALL_SIZE;
+    bool new_small = p_nsize <= MAX_SMALL_SIZE;
+
+    if (old_small && new_small && size_class(p_osize) == size_class(p_nsize)) {
+        stats.live_bytes = stats.live_bytes - p_osize + p_nsize;
+        if (stats.live_bytes > stats.peak_bytes) {
+            stats.peak_bytes = stats.live_bytes;
+        }
+        return p_ptr;
+    }
+
+    if (!old_small && !new_small) {
+        void *ptr = memrealloc(p_ptr, p_nsize);
+        if (!ptr) {
+            return nullptr;
+        }
+
+        stats.live_bytes = stats.live_bytes - p_osize + p_nsize;
+        if (stats.live_bytes > stats.peak_bytes) {
+            stats.peak_bytes = stats.live_bytes;
+        }
+        return ptr;
+    }
+
+    // Moving between the pool and the general heap
+    void *ptr = allocate(p_nsize);
+    if (!ptr) {
+        return nullptr;
+    }
+
+    memcpy(ptr, p_ptr, p_osize < p_nsize ? p_osize : p_nsize);
+    deallocate(p_ptr, p_osize);
+
+    return ptr;
+}
+
+void *LuauAllocator::lua_alloc(void *p_ud, void *p_ptr, size_t p_osize, size_t p_nsize) {
+    return ((LuauAllocator *)p_ud)->reallocate(p_ptr, p_osize, p_nsize);
+}
+
+LuauAllocator::~LuauAllocator() {
+    for (void *chunk : chunks) {
+        memfree(chunk);
+    }
+    chunks.clear();
+}
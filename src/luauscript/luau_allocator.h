@@ -0,0 +1,76 @@
+#ifndef LUAU_ALLOCATOR_H
+#define LUAU_ALLOCATOR_H
+
+#include <godot_cpp/templates/local_vector.hpp>
+
+#include <cstddef>
+#include <cstdint>
+
+namespace godot {
+
+//MARK: LuauAllocator
+// Heap backend for one lua_State. Small blocks come from size-class free lists
+// carved out of large chunks; anything bigger goes straight to memrealloc.
+// A VM is only ever touched by one thread at a time, so the pool needs no locking.
+class LuauAllocator {
+public:
+    static constexpr size_t SIZE_CLASS_STEP = 16;
+    static constexpr size_t MAX_SMALL_SIZE = 512;
+    static constexpr size_t SIZE_CLASS_COUNT = MAX_SMALL_SIZE / SIZE_CLASS_STEP;
+    static constexpr size_t CHUNK_SIZE = 64 * 1024;
+
+    struct Stats {
+        uint64_t live_bytes = 0;
+        uint64_t peak_bytes = 0;
+        uint64_t allocations = 0;
+        uint64_t frees = 0;
+    };
+
+private:
+    struct FreeBlock {
+        FreeBlock *next;
+    };
+
+    FreeBlock *free_lists[SIZE_CLASS_COUNT] = {};
+
+    LocalVector<void *> chunks;
+    uint8_t *chunk_cursor = nullptr;
+    uint8_t *chunk_end = nullptr;
+
+    Stats stats;
+    uint64_t limit_bytes = 0; // 0 means unlimited
+    uint32_t protected_depth = 0;
+
+    static size_t size_class(size_t p_size) { return (p_size - 1) / SIZE_CLASS_STEP; }
+
+    void *alloc_small(size_t p_class);
+    void free_small(void *p_ptr, size_t p_class);
+
+    void *allocate(size_t p_size);
+    void deallocate(void *p_ptr, size_t p_size);
+
+public:
+    // lua_Alloc entry point; p_ud is the LuauAllocator passed to lua_newstate.
+    static void *lua_alloc(void *p_ud, void *p_ptr, size_t p_osize, size_t p_nsize);
+
+    void *reallocate(void *p_ptr, size_t p_osize, size_t p_nsize);
+
+    const Stats &get_stats() const { return stats; }
+
+    // Growth past the limit fails, which Luau reports as LUA_ERRMEM. Only enforced inside
+    // protected calls, where the error is caught; the engine's own pushes outside of
+    // one would otherwise raise it with nothing to catch it.
+    void set_limit(uint64_t p_bytes) { limit_bytes = p_bytes; }
+    uint64_t get_limit() const { return limit_bytes; }
+    void enter_protected() { protected_depth++; }
+    void exit_protected() { protected_depth--; }
+
+    LuauAllocator() = default;
+    LuauAllocator(const LuauAllocator &) = delete;
+    LuauAllocator &operator=(const LuauAllocator &) = delete;
+    ~LuauAllocator();
+};
+
+}; // namespace godot
+
+#endif
@@ -1,27 +1,277 @@
 #include "luau_bridge.h"
 #include "lamda_wrapper.h"
 
+#include <godot_cpp/godot.hpp>
 #include <godot_cpp/variant/variant.hpp>
 #include <godot_cpp/variant/callable.hpp>
 #include "variant/builtin_types.h"
 
+#include <cstring>
+
 using namespace godot;
 
-void *LuauBridge::luaL_checkudata(lua_State *L, int p_index, const char *p_tname) {
-    void *p = lua_touserdata(L, p_index);
+LuauBridge::TagGetter LuauBridge::tag_getters[UDTAG_MAX] = {};
+const char *LuauBridge::tag_names[UDTAG_MAX] = {};
+bool LuauBridge::native_vectors = false;
+
+void LuauBridge::register_tag(lua_State *L, int p_tag, const char *p_name, TagGetter p_getter, lua_Destructor p_dtor) {
+    ERR_FAIL_INDEX(p_tag, UDTAG_MAX);
+
+    // Same for every VM, so the tables are shared process-wide
+    tag_getters[p_tag] = p_getter;
+    tag_names[p_tag] = p_name;
+
+    lua_setuserdatametatable(L, p_tag);
+    if (p_dtor) {
+        lua_setuserdatadtor(L, p_tag, p_dtor);
+    }
+}
+
+static const char *ATOM_NAMES[LuauBridge::ATOM_MAX] = {
+    "x", "y", "z", "w",
+    "r", "g", "b", "a",
+    "origin", "basis", "position", "size", "end", "normal", "d",
+};
+
+int16_t LuauBridge::user_atom(const char *p_str, size_t p_len) {
+    // Runs once per interned string, so a linear scan is fine
+    for (int i = 0; i < ATOM_MAX; i++) {
+        if (strlen(ATOM_NAMES[i]) == p_len && memcmp(ATOM_NAMES[i], p_str, p_len) == 0) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+void LuauBridge::register_method_names(lua_State *L) {
+    lua_setuserdatadtor(L, UDTAG_METHOD_NAME, [](lua_State *L, void *p_ud) {
+        ((MethodBinding *)p_ud)->~MethodBinding();
+    });
+}
+
+//MARK: Builtin methods
+struct BuiltinMethodEntry {
+    Variant::Type type;
+    const char *name;
+    GDExtensionInt hash;
+    int return_type;
+    int arg_count;
+    int first_arg;
+};
+
+#include "variant/builtin_methods.gen.h"
+
+// Types that live in the VM as bridged userdata, so the userdata is the ptrcall value
+static bool is_userdata_type(int p_type) {
+    switch (p_type) {
+        case Variant::AABB:
+        case Variant::BASIS:
+        case Variant::CALLABLE:
+        case Variant::COLOR:
+        case Variant::PLANE:
+        case Variant::QUATERNION:
+        case Variant::RECT2:
+        case Variant::RECT2I:
+        case Variant::RID:
+        case Variant::SIGNAL:
+        case Variant::TRANSFORM2D:
+        case Variant::TRANSFORM3D:
+        case Variant::VECTOR2:
+        case Variant::VECTOR2I:
+        case Variant::VECTOR3I:
+        case Variant::VECTOR4:
+        case Variant::VECTOR4I:
+            return true;
+        default:
+            return false;
+    }
+}
+
+static bool is_ptrcall_type(int p_type) {
+    switch (p_type) {
+        case Variant::BOOL:
+        case Variant::INT:
+        case Variant::FLOAT:
+        case Variant::STRING:
+        case Variant::VECTOR3:
+        case Variant::VARIANT_MAX:
+            return true;
+        default:
+            return is_userdata_type(p_type);
+    }
+}
+
+static void *push_userdata_return(lua_State *L, int p_type) {
+    switch (p_type) {
+        case Variant::AABB: return AABBBridge::push_new(L);
+        case Variant::BASIS: return BasisBridge::push_new(L);
+        case Variant::CALLABLE: return CallableBridge::push_new(L);
+        case Variant::COLOR: return ColorBridge::push_new(L);
+        case Variant::PLANE: return PlaneBridge::push_new(L);
+        case Variant::QUATERNION: return QuaternionBridge::push_new(L);
+        case Variant::RECT2: return Rect2Bridge::push_new(L);
+        case Variant::RECT2I: return Rect2iBridge::push_new(L);
+        case Variant::RID: return RIDBridge::push_new(L);
+        case Variant::SIGNAL: return SignalBridge::push_new(L);
+        case Variant::TRANSFORM2D: return Transform2DBridge::push_new(L);
+        case Variant::TRANSFORM3D: return Transform3DBridge::push_new(L);
+        case Variant::VECTOR2: return Vector2Bridge::push_new(L);
+        case Variant::VECTOR2I: return Vector2iBridge::push_new(L);
+        case Variant::VECTOR3I: return Vector3iBridge::push_new(L);
+        case Variant::VECTOR4: return Vector4Bridge::push_new(L);
+        case Variant::VECTOR4I: return Vector4iBridge::push_new(L);
+        default: return nullptr;
+    }
+}
+
+void LuauBridge::resolve_builtin_method(Variant::Type p_type, const char *p_name, BuiltinMethod &r_method) {
+    r_method = BuiltinMethod();
+
+    // Runs once per method, type and VM, so a linear scan is fine
+    for (const BuiltinMethodEntry &entry : BUILTIN_METHODS) {
+        if (entry.type != p_type || strcmp(entry.name, p_name) != 0) {
+            continue;
+        }
+
+        if (entry.arg_count > BUILTIN_MAX_ARGS || (entry.return_type != -1 && !is_ptrcall_type(entry.return_type))) {
+            return;
+        }
+
+        const int *arg_types = BUILTIN_METHOD_ARGS + entry.first_arg;
+        for (int i = 0; i < entry.arg_count; i++) {
+            if (!is_ptrcall_type(arg_types[i])) {
+                return;
+            }
+        }
+
+        // Null when the running engine's hash differs from the API godot-cpp was built with
+        StringName name(p_name);
+        r_method.call = internal::gdextension_interface_variant_get_ptr_builtin_method(GDExtensionVariantType(p_type), name._native_ptr(), entry.hash);
+        r_method.return_type = entry.return_type;
+        r_method.arg_count = entry.arg_count;
+        r_method.arg_types = arg_types;
+        return;
+    }
+}
 
-    if (p != NULL) {
-        if (lua_getmetatable(L, p_index)) {
-            lua_getfield(L, LUA_REGISTRYINDEX, p_tname);
-            if (lua_rawequal(L, -1, -2)) {
-                lua_pop(L, 2);
-                return p;
+int LuauBridge::call_builtin_method(lua_State *L, const BuiltinMethod &p_method, void *p_base, int p_first_arg, int p_argc) {
+    // Typed storage for arguments that aren't userdata; only the member in use is constructed
+    union ArgSlot {
+        int64_t i;
+        double f;
+        GDExtensionBool b;
+        alignas(Variant) uint8_t object[sizeof(Variant)];
+
+        ArgSlot() {}
+    };
+    static_assert(sizeof(String) <= sizeof(Variant) && sizeof(Vector3) <= sizeof(Variant), "ArgSlot::object is too small");
+
+    ArgSlot slots[BUILTIN_MAX_ARGS];
+    GDExtensionConstTypePtr args[BUILTIN_MAX_ARGS];
+    uint32_t strings = 0;
+    uint32_t variants = 0;
+
+    auto release = [&]() {
+        for (int i = 0; i < p_argc; i++) {
+            if (strings & (1u << i)) {
+                reinterpret_cast<String *>(slots[i].object)->~String();
+            } else if (variants & (1u << i)) {
+                reinterpret_cast<Variant *>(slots[i].object)->~Variant();
             }
         }
+    };
+
+    for (int i = 0; i < p_argc; i++) {
+        int index = p_first_arg + i;
+        int type = p_method.arg_types[i];
+        int value_type = lua_type(L, index);
+
+        if (type == Variant::VARIANT_MAX) {
+            new (slots[i].object) Variant(get_variant(L, index));
+            variants |= 1u << i;
+            args[i] = slots[i].object;
+        } else if (type == Variant::FLOAT && value_type == LUA_TNUMBER) {
+            slots[i].f = lua_tonumber(L, index);
+            args[i] = &slots[i].f;
+        } else if (type == Variant::INT && value_type == LUA_TNUMBER) {
+            slots[i].i = int64_t(lua_tonumber(L, index));
+            args[i] = &slots[i].i;
+        } else if (type == Variant::BOOL && value_type == LUA_TBOOLEAN) {
+            slots[i].b = lua_toboolean(L, index) ? 1 : 0;
+            args[i] = &slots[i].b;
+        } else if (type == Variant::STRING && value_type == LUA_TSTRING) {
+            new (slots[i].object) String(get_string(L, index));
+            strings |= 1u << i;
+            args[i] = slots[i].object;
+        } else if (type == Variant::VECTOR3 && value_type == LUA_TVECTOR) {
+            const float *v = lua_tovector(L, index);
+            new (slots[i].object) Vector3(v[0], v[1], v[2]);
+            args[i] = slots[i].object;
+        } else if (value_type == LUA_TUSERDATA && lua_userdatatag(L, index) == type) {
+            args[i] = lua_touserdata(L, index);
+        } else {
+            // Needs a conversion (int vector to float vector, table to Array, ...)
+            release();
+            return -1;
+        }
     }
 
-    luaL_typeerror(L, p_index, p_tname);
-    return NULL;
+    int results = 1;
+    switch (p_method.return_type) {
+        case -1: {
+            p_method.call(p_base, args, nullptr, p_argc);
+            results = 0;
+            break;
+        }
+        case Variant::BOOL: {
+            GDExtensionBool ret = 0;
+            p_method.call(p_base, args, &ret, p_argc);
+            lua_pushboolean(L, ret);
+            break;
+        }
+        case Variant::INT: {
+            int64_t ret = 0;
+            p_method.call(p_base, args, &ret, p_argc);
+            lua_pushinteger(L, ret);
+            break;
+        }
+        case Variant::FLOAT: {
+            double ret = 0;
+            p_method.call(p_base, args, &ret, p_argc);
+            lua_pushnumber(L, ret);
+            break;
+        }
+        case Variant::STRING: {
+            String ret;
+            p_method.call(p_base, args, &ret, p_argc);
+            push_string(L, ret);
+            break;
+        }
+        case Variant::VECTOR3: {
+            Vector3 ret;
+            p_method.call(p_base, args, &ret, p_argc);
+            Vector3Bridge::push_value(L, ret);
+            break;
+        }
+        case Variant::VARIANT_MAX: {
+            Variant ret;
+            p_method.call(p_base, args, &ret, p_argc);
+            push_variant(L, ret);
+            break;
+        }
+        default: {
+            // Written straight into the new userdata
+            p_method.call(p_base, args, push_userdata_return(L, p_method.return_type), p_argc);
+            break;
+        }
+    }
+
+    release();
+    return results;
+}
+
+const char *LuauBridge::get_tag_name(int p_tag) {
+    return (p_tag > 0 && p_tag < UDTAG_MAX) ? tag_names[p_tag] : nullptr;
 }
 
 void LuauBridge::push_string(lua_State *L, const String &p_str) {
@@ -170,7 +420,7 @@ void LuauBridge::push_variant(lua_State *L, const Variant &p_var) {
         }
 
         case Variant::VECTOR3: {
-            Vector3Bridge::push_from(L, p_var.operator Vector3());
+            Vector3Bridge::push_value(L, p_var.operator Vector3());
             break;
         }
 
@@ -268,6 +518,11 @@ Variant LuauBridge::get_variant(lua_State *L, int p_index) {
             
         case LUA_TSTRING:
             return Variant(get_string(L, p_index));
+
+        case LUA_TVECTOR: {
+            const float *v = lua_tovector(L, p_index);
+            return Variant(Vector3(v[0], v[1], v[2]));
+        }
             
         case LUA_TTABLE: {
             // Get the table's metatable
@@ -305,133 +560,12 @@ Variant LuauBridge::get_variant(lua_State *L, int p_index) {
         }
 
         case LUA_TUSERDATA: {
-            void* ud = lua_touserdata(L, p_index);
-            if (!ud) {
-                WARN_PRINT("Invalid userdata");
-                return Variant();
-            }
-
-            // Get the userdata's metatable
-            if (!lua_getmetatable(L, p_index)) {
-                WARN_PRINT("Userdata without metatable");
-                return Variant();
+            int tag = lua_userdatatag(L, p_index);
+            if (tag > 0 && tag < UDTAG_MAX && tag_getters[tag]) {
+                return tag_getters[tag](L, p_index);
             }
 
-            // Get the type name
-            lua_getfield(L, -1, "__type");
-            if (lua_isnil(L, -1)) {
-                lua_pop(L, 2); // Pop metatable and nil __type
-                WARN_PRINT("Userdata metatable without __type");
-                return Variant();
-            }
-            const char* type_name = lua_tostring(L, -1);
-
-            // Get the registered metatable for this type
-            lua_getfield(L, LUA_REGISTRYINDEX, type_name);
-            if (lua_isnil(L, -1)) {
-                lua_pop(L, 3); // Pop registered metatable, type name, and userdata metatable
-                WARN_PRINT("Type not registered: " + String(type_name));
-                return Variant();
-            }
-
-            // Compare the metatables
-            bool equal = lua_rawequal(L, -1, -3);
-            lua_pop(L, 3);
-
-            if (!equal) {
-                WARN_PRINT("Userdata metatable does not match registered type: " + String(type_name));
-                return Variant();
-            }
-
-            // Now we know it's a valid userdata of our type
-
-            String type_str(type_name);
-            if (type_str == "Vector2") {
-                return Vector2Bridge::get_object(L, p_index);
-            } else if (type_str == "Vector2i") {
-                return Vector2iBridge::get_object(L, p_index);
-            } else if (type_str == "Rect2") {
-                return Rect2Bridge::get_object(L, p_index);
-            } else if (type_str == "Rect2i") {
-                return Rect2iBridge::get_object(L, p_index);
-            } else if (type_str == "Vector3") {
-                return Vector3Bridge::get_object(L, p_index);
-            } else if (type_str == "Vector3i") {
-                return Vector3iBridge::get_object(L, p_index);
-            } else if (type_str == "Transform2D") {
-                return Transform2DBridge::get_object(L, p_index);
-            } else if (type_str == "Vector4") {
-                return Vector4Bridge::get_object(L, p_index);
-            } else if (type_str == "Vector4i") {
-                return Vector4iBridge::get_object(L, p_index);
-            } else if (type_str == "Plane") {
-                return PlaneBridge::get_object(L, p_index);
-            } else if (type_str == "Quaternion") {
-                return QuaternionBridge::get_object(L, p_index);
-            } else if (type_str == "AABB") {
-                return AABBBridge::get_object(L, p_index);
-            } else if (type_str == "Basis") {
-                return BasisBridge::get_object(L, p_index);
-            } else if (type_str == "Transform3D") {
-                return Transform3DBridge::get_object(L, p_index);
-            } else if (type_str == "Projection") {
-                return ProjectionBridge::get_object(L, p_index);
-
-            } else if (type_str == "Color") {
-                return ColorBridge::get_object(L, p_index);
-            } else if (type_str == "StringName") {
-                return StringNameBridge::get_object(L, p_index);
-            } else if (type_str == "RID") {
-                return RIDBridge::get_object(L, p_index);
-            } else if (type_str == "Callable") {
-                return CallableBridge::get_object(L, p_index);
-            } else if (type_str == "Signal") {
-                return SignalBridge::get_object(L, p_index);
-            } else if (type_str == "Dictionary") {
-                return DictionaryBridge::get_object(L, p_index);
-            } else if (type_str == "Array") {
-                return ArrayBridge::get_object(L, p_index);
-
-            } else if (type_str == "PackedByteArray") {
-                return PackedByteArrayBridge::get_object(L, p_index);
-            } else if (type_str == "PackedInt32Array") {
-                return PackedInt32ArrayBridge::get_object(L, p_index);
-            } else if (type_str == "PackedInt64Array") {
-                return PackedInt64ArrayBridge::get_object(L, p_index);
-            } else if (type_str == "PackedFloat32Array") {
-                return PackedFloat32ArrayBridge::get_object(L, p_index);
-            } else if (type_str == "PackedFloat64Array") {
-                return PackedFloat64ArrayBridge::get_object(L, p_index);
-            } else if (type_str == "PackedStringArray") {
-                return PackedStringArrayBridge::get_object(L, p_index);
-            } else if (type_str == "PackedVector2Array") {
-                return PackedVector2ArrayBridge::get_object(L, p_index);
-            } else if (type_str == "PackedVector3Array") {
-                return PackedVector3ArrayBridge::get_object(L, p_index);
-            } else if (type_str == "PackedVector4Array") {
-                return PackedVector4ArrayBridge::get_object(L, p_index);
-            } else if (type_str == "PackedColorArray") {
-                return PackedColorArrayBridge::get_object(L, p_index);
-
-            } else if (type_str == "Object") {
-                return ObjectBridge::get_object(L, p_index);
-                
-            } else if (type_str == "OnReadyWrapper") {
-                void** proxy = (void**)lua_touserdata(L, p_index);
-
-                if (proxy == nullptr || *proxy == nullptr) {
-                    luaL_error(L, "Proxy is null or uninitialized");
-                    return 0;
-                }
-
-                void* result = *proxy;
-                Variant* proxy_var = (Variant*)result;
-
-                //WARN_PRINT(vformat("get_variant = %s", String(*proxy_var)));
-                return *proxy_var;
-            }
-
-            WARN_PRINT("Unhandled userdata type: " + String(type_name));
+            WARN_PRINT(vformat("Unhandled userdata tag: %d", tag));
             return Variant();
         }
 
@@ -480,18 +614,16 @@ void VariantBridge<GDV, __eq>::register_variant(lua_State *L) {
     lua_pushstring(L, variant_name);
     lua_settable(L, -3);
 
+    // The upvalue caches this type's method closures
     lua_pushstring(L, "__index");
-    lua_pushcfunction(L, on_index, "__index");
+    lua_newtable(L);
+    lua_pushcclosure(L, on_index, "__index", 1);
     lua_settable(L, -3);
 
     lua_pushstring(L, "__newindex");
     lua_pushcfunction(L, on_newindex, "__newindex");
     lua_settable(L, -3);
 
-    lua_pushstring(L, "__gc");
-    lua_pushcfunction(L, on_gc, "__gc");
-    lua_settable(L, -3);
-
     lua_pushstring(L, "__call");
     lua_pushcfunction(L, on_call, "__call");
     lua_settable(L, -3);
@@ -531,6 +663,12 @@ void VariantBridge<GDV, __eq>::register_variant(lua_State *L) {
     lua_settable(L, -3);
 
     lua_setreadonly(L, -1, true);
+
+    // Plain values (vectors, colors, transforms) need no destructor call when collected
+    lua_Destructor dtor = std::is_trivially_destructible<GDV>::value ? nullptr : on_destroy;
+
+    lua_pushvalue(L, -1);
+    LuauBridge::register_tag(L, variant_tag, variant_name, to_variant, dtor);
     lua_pop(L, 1);
 }
 
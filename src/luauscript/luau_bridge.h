@@ -4,16 +4,90 @@
 #include <godot_cpp/variant/variant.hpp>
 #include <godot_cpp/variant/array.hpp>
 #include <godot_cpp/core/memory.hpp>
+#include <godot_cpp/core/type_info.hpp>
+#include <godot_cpp/templates/local_vector.hpp>
 
 #include <lua.h>
 #include <lualib.h>
 
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+
 namespace godot {
 
 //MARK: LuauBridge
 class LuauBridge {
     public:
-        static void *luaL_checkudata(lua_State *L, int p_index, const char *p_tname);
+        // Userdata tags. Bridged values are tagged with their Variant::Type, so the
+        // VM finds metatable and destructor by index; tag 0 is plain lua_newuserdata.
+        enum {
+            UDTAG_ON_READY = Variant::VARIANT_MAX, // OnReadyWrapper proxies
+            UDTAG_METHOD_NAME, // StringName upvalues of cached method closures
+            UDTAG_MAX,
+        };
+
+        typedef Variant (*TagGetter)(lua_State *L, int p_index);
+
+        // Binds the metatable on top of the stack (popped) to p_tag, plus how to read
+        // the userdata back as a Variant and, for non-trivial types, its destructor.
+        static void register_tag(lua_State *L, int p_tag, const char *p_name, TagGetter p_getter, lua_Destructor p_dtor);
+        static const char *get_tag_name(int p_tag);
+
+        // String atoms for value type members; assigned once per interned string by
+        // the VM's useratom callback, so field access switches on an int.
+        enum Atom {
+            ATOM_X,
+            ATOM_Y,
+            ATOM_Z,
+            ATOM_W,
+            ATOM_R,
+            ATOM_G,
+            ATOM_B,
+            ATOM_A,
+            ATOM_ORIGIN,
+            ATOM_BASIS,
+            ATOM_POSITION,
+            ATOM_SIZE,
+            ATOM_END,
+            ATOM_NORMAL,
+            ATOM_D,
+            ATOM_MAX,
+        };
+
+        static int16_t user_atom(const char *p_str, size_t p_len);
+
+        // Ptrcall entry for a builtin method, found in the table generated from
+        // extension_api.json. call stays null for signatures that need a Variant round trip.
+        struct BuiltinMethod {
+            GDExtensionPtrBuiltInMethod call = nullptr;
+            int return_type = -1; // Variant::Type, VARIANT_MAX for Variant, -1 for none
+            int arg_count = 0;
+            const int *arg_types = nullptr;
+        };
+
+        static constexpr int BUILTIN_MAX_ARGS = 8;
+
+        // Upvalue of cached method closures (UDTAG_METHOD_NAME userdata).
+        struct MethodBinding {
+            StringName name;
+            BuiltinMethod builtin;
+        };
+
+        // Destructor for the MethodBinding userdata held by cached method closures.
+        static void register_method_names(lua_State *L);
+
+        static void resolve_builtin_method(Variant::Type p_type, const char *p_name, BuiltinMethod &r_method);
+
+        // Calls p_method on p_base with the p_argc Lua values from p_first_arg, converted straight
+        // into ptrcall arguments. Returns the number of results, or -1 (stack untouched) when an
+        // argument isn't a direct match and the caller has to go through Variant::callp().
+        static int call_builtin_method(lua_State *L, const BuiltinMethod &p_method, void *p_base, int p_first_arg, int p_argc);
+
+        // Opt-in (luau/runtime/native_vectors): Vector3 is Luau's builtin vector value
+        // instead of userdata. Fixed before the VMs are created, as bytecode depends on it.
+        static void set_native_vectors(bool p_enabled) { native_vectors = p_enabled; }
+        static bool is_native_vectors() { return native_vectors; }
 
         static void push_string(lua_State *L, const godot::String &p_str);
         static void push_dictionary(lua_State *L, const Dictionary &p_dict);
@@ -26,45 +100,407 @@ class LuauBridge {
         static Variant get_variant(lua_State *L, int p_index);
 
         static void protect_metatable(lua_State* thread, int index);
+
+    private:
+        static TagGetter tag_getters[UDTAG_MAX];
+        static const char *tag_names[UDTAG_MAX];
+        static bool native_vectors;
+};
+
+static_assert(LuauBridge::UDTAG_MAX <= LUA_UTAG_LIMIT, "Too many userdata tags for this Luau build");
+
+
+//MARK: Bridge operators
+// Compile-time operator tables for the float math types. Each type lists the right-hand
+// operands it has typed fast paths for; the pair is only used when the C++ operator
+// exists and returns a bridged type. Integer vectors are left to Variant::evaluate,
+// which owns their division by zero errors and int * float promotion.
+template <class... T>
+struct BridgeTypeList {};
+
+using BridgeMathTypes = BridgeTypeList<Vector2, Vector3, Vector4, Color, Quaternion, Basis, Transform2D, Transform3D, Projection, Plane, AABB, Rect2>;
+
+template <class T, class List>
+struct bridge_list_has;
+
+template <class T, class... U>
+struct bridge_list_has<T, BridgeTypeList<U...>> : std::bool_constant<(std::is_same<T, U>::value || ...)> {};
+
+template <class GDV>
+struct BridgeOperands { using type = BridgeTypeList<GDV>; };
+template <>
+struct BridgeOperands<Quaternion> { using type = BridgeTypeList<Quaternion, Vector3>; };
+template <>
+struct BridgeOperands<Basis> { using type = BridgeTypeList<Basis, Vector3>; };
+template <>
+struct BridgeOperands<Transform2D> { using type = BridgeTypeList<Transform2D, Vector2, Rect2>; };
+template <>
+struct BridgeOperands<Transform3D> { using type = BridgeTypeList<Transform3D, Vector3, AABB, Plane>; };
+template <>
+struct BridgeOperands<Projection> { using type = BridgeTypeList<Projection, Vector4>; };
+
+// Types whose * and / by a number are plain component-wise math
+template <class GDV>
+struct BridgeScalar : std::bool_constant<bridge_list_has<GDV, BridgeTypeList<Vector2, Vector3, Vector4, Color, Quaternion>>::value> {};
+
+template <Variant::Operator OP>
+struct BridgeOp {};
+template <>
+struct BridgeOp<Variant::OP_EQUAL> { template <class A, class B> static auto apply(const A &a, const B &b) -> decltype(a == b) { return a == b; } };
+template <>
+struct BridgeOp<Variant::OP_ADD> { template <class A, class B> static auto apply(const A &a, const B &b) -> decltype(a + b) { return a + b; } };
+template <>
+struct BridgeOp<Variant::OP_SUBTRACT> { template <class A, class B> static auto apply(const A &a, const B &b) -> decltype(a - b) { return a - b; } };
+template <>
+struct BridgeOp<Variant::OP_MULTIPLY> { template <class A, class B> static auto apply(const A &a, const B &b) -> decltype(a * b) { return a * b; } };
+template <>
+struct BridgeOp<Variant::OP_DIVIDE> { template <class A, class B> static auto apply(const A &a, const B &b) -> decltype(a / b) { return a / b; } };
+
+template <Variant::Operator OP, class A, class B, class = void>
+struct bridge_op_result { static constexpr bool valid = false; };
+
+template <Variant::Operator OP, class A, class B>
+struct bridge_op_result<OP, A, B, std::void_t<decltype(BridgeOp<OP>::apply(std::declval<const A &>(), std::declval<const B &>()))>> {
+    using type = std::decay_t<decltype(BridgeOp<OP>::apply(std::declval<const A &>(), std::declval<const B &>()))>;
+    static constexpr bool valid = std::is_same<type, bool>::value || bridge_list_has<type, BridgeMathTypes>::value;
+};
+
+template <class T>
+bool bridge_read(lua_State *L, int p_index, T &r_value) {
+    if constexpr (std::is_same<T, Vector3>::value) {
+        if (lua_isvector(L, p_index)) {
+            const float *v = lua_tovector(L, p_index);
+            r_value = Vector3(v[0], v[1], v[2]);
+            return true;
+        }
+    }
+
+    T *ud = (T *)lua_touserdatatagged(L, p_index, GetTypeInfo<T>::VARIANT_TYPE);
+    if (!ud) {
+        return false;
+    }
+
+    r_value = *ud;
+    return true;
+}
+
+template <class T>
+void bridge_push(lua_State *L, const T &p_value) {
+    if constexpr (std::is_same<T, bool>::value) {
+        lua_pushboolean(L, p_value);
+    } else {
+        if constexpr (std::is_same<T, Vector3>::value) {
+            if (LuauBridge::is_native_vectors()) {
+                lua_pushvector(L, p_value.x, p_value.y, p_value.z);
+                return;
+            }
+        }
+
+        T *ud = (T *)lua_newuserdatataggedwithmetatable(L, sizeof(T), GetTypeInfo<T>::VARIANT_TYPE);
+        new (ud) T(p_value);
+    }
+}
+
+template <Variant::Operator OP, class A, class B>
+bool bridge_apply_rhs(lua_State *L, const A &p_a) {
+    if constexpr (bridge_op_result<OP, A, B>::valid) {
+        B b;
+        if (bridge_read(L, 2, b)) {
+            bridge_push(L, BridgeOp<OP>::apply(p_a, b));
+            return true;
+        }
+    }
+    return false;
+}
+
+template <Variant::Operator OP, class A, class... B>
+bool bridge_try_rhs(lua_State *L, const A &p_a, BridgeTypeList<B...>) {
+    return (bridge_apply_rhs<OP, A, B>(L, p_a) || ...);
+}
+
+template <Variant::Operator OP, class GDV>
+bool bridge_fast_operator(lua_State *L) {
+    constexpr bool scalar = BridgeScalar<GDV>::value && (OP == Variant::OP_MULTIPLY || OP == Variant::OP_DIVIDE);
+
+    GDV a;
+    if (bridge_read(L, 1, a)) {
+        if (bridge_try_rhs<OP>(L, a, typename BridgeOperands<GDV>::type())) {
+            return true;
+        }
+
+        if constexpr (scalar) {
+            if (lua_type(L, 2) == LUA_TNUMBER) {
+                bridge_push(L, BridgeOp<OP>::apply(a, real_t(lua_tonumber(L, 2))));
+                return true;
+            }
+        }
+    } else if constexpr (scalar && OP == Variant::OP_MULTIPLY) {
+        // number * value; the metamethod comes from the right operand
+        if (lua_type(L, 1) == LUA_TNUMBER && bridge_read(L, 2, a)) {
+            bridge_push(L, a * real_t(lua_tonumber(L, 1)));
+            return true;
+        }
+    }
+
+    return false;
+}
+
+
+//MARK: Bridge fields
+// Direct member access for value types, keyed by LuauBridge::Atom. get pushes the
+// member, set reads it from p_index into the userdata in place; both return false
+// for members they don't know, which then go through Variant.
+template <class T>
+bool bridge_push_field(lua_State *L, const T &p_value) {
+    if constexpr (std::is_arithmetic<T>::value) {
+        lua_pushnumber(L, p_value);
+    } else {
+        bridge_push(L, p_value);
+    }
+    return true;
+}
+
+template <class T>
+bool bridge_check_field(lua_State *L, int p_index, T &r_value) {
+    if constexpr (std::is_integral<T>::value) {
+        r_value = T(luaL_checkinteger(L, p_index));
+    } else if constexpr (std::is_floating_point<T>::value) {
+        r_value = T(luaL_checknumber(L, p_index));
+    } else if (!bridge_read(L, p_index, r_value)) {
+        luaL_typeerror(L, p_index, Variant::get_type_name(Variant::Type(GetTypeInfo<T>::VARIANT_TYPE)).utf8().get_data());
+    }
+    return true;
+}
+
+template <class T>
+struct BridgeFields {
+    static bool get(lua_State *L, const T &p_value, int p_atom) { return false; }
+    static bool set(lua_State *L, T &r_value, int p_atom, int p_index) { return false; }
+};
+
+// Vector2/3/4 and their integer variants
+template <class T, int N>
+struct BridgeVectorFields {
+    static bool get(lua_State *L, const T &p_value, int p_atom) {
+        if (p_atom >= LuauBridge::ATOM_X && p_atom < LuauBridge::ATOM_X + N) {
+            return bridge_push_field(L, p_value[p_atom - LuauBridge::ATOM_X]);
+        }
+        return false;
+    }
+
+    static bool set(lua_State *L, T &r_value, int p_atom, int p_index) {
+        if (p_atom >= LuauBridge::ATOM_X && p_atom < LuauBridge::ATOM_X + N) {
+            return bridge_check_field(L, p_index, r_value[p_atom - LuauBridge::ATOM_X]);
+        }
+        return false;
+    }
+};
+
+template <> struct BridgeFields<Vector2> : BridgeVectorFields<Vector2, 2> {};
+template <> struct BridgeFields<Vector2i> : BridgeVectorFields<Vector2i, 2> {};
+template <> struct BridgeFields<Vector3> : BridgeVectorFields<Vector3, 3> {};
+template <> struct BridgeFields<Vector3i> : BridgeVectorFields<Vector3i, 3> {};
+template <> struct BridgeFields<Vector4> : BridgeVectorFields<Vector4, 4> {};
+template <> struct BridgeFields<Vector4i> : BridgeVectorFields<Vector4i, 4> {};
+
+template <>
+struct BridgeFields<Quaternion> {
+    static bool get(lua_State *L, const Quaternion &p_value, int p_atom) {
+        switch (p_atom) {
+            case LuauBridge::ATOM_X: return bridge_push_field(L, p_value.x);
+            case LuauBridge::ATOM_Y: return bridge_push_field(L, p_value.y);
+            case LuauBridge::ATOM_Z: return bridge_push_field(L, p_value.z);
+            case LuauBridge::ATOM_W: return bridge_push_field(L, p_value.w);
+        }
+        return false;
+    }
+
+    static bool set(lua_State *L, Quaternion &r_value, int p_atom, int p_index) {
+        switch (p_atom) {
+            case LuauBridge::ATOM_X: return bridge_check_field(L, p_index, r_value.x);
+            case LuauBridge::ATOM_Y: return bridge_check_field(L, p_index, r_value.y);
+            case LuauBridge::ATOM_Z: return bridge_check_field(L, p_index, r_value.z);
+            case LuauBridge::ATOM_W: return bridge_check_field(L, p_index, r_value.w);
+        }
+        return false;
+    }
+};
+
+template <>
+struct BridgeFields<Color> {
+    static bool get(lua_State *L, const Color &p_value, int p_atom) {
+        switch (p_atom) {
+            case LuauBridge::ATOM_R: return bridge_push_field(L, p_value.r);
+            case LuauBridge::ATOM_G: return bridge_push_field(L, p_value.g);
+            case LuauBridge::ATOM_B: return bridge_push_field(L, p_value.b);
+            case LuauBridge::ATOM_A: return bridge_push_field(L, p_value.a);
+        }
+        return false;
+    }
+
+    static bool set(lua_State *L, Color &r_value, int p_atom, int p_index) {
+        switch (p_atom) {
+            case LuauBridge::ATOM_R: return bridge_check_field(L, p_index, r_value.r);
+            case LuauBridge::ATOM_G: return bridge_check_field(L, p_index, r_value.g);
+            case LuauBridge::ATOM_B: return bridge_check_field(L, p_index, r_value.b);
+            case LuauBridge::ATOM_A: return bridge_check_field(L, p_index, r_value.a);
+        }
+        return false;
+    }
+};
+
+// Rect2, Rect2i and AABB share position/size/end
+template <class T, class V>
+struct BridgeBoxFields {
+    static bool get(lua_State *L, const T &p_value, int p_atom) {
+        switch (p_atom) {
+            case LuauBridge::ATOM_POSITION: return bridge_push_field(L, p_value.position);
+            case LuauBridge::ATOM_SIZE: return bridge_push_field(L, p_value.size);
+            case LuauBridge::ATOM_END: return bridge_push_field(L, p_value.get_end());
+        }
+        return false;
+    }
+
+    static bool set(lua_State *L, T &r_value, int p_atom, int p_index) {
+        switch (p_atom) {
+            case LuauBridge::ATOM_POSITION: return bridge_check_field(L, p_index, r_value.position);
+            case LuauBridge::ATOM_SIZE: return bridge_check_field(L, p_index, r_value.size);
+            case LuauBridge::ATOM_END: {
+                V end;
+                bridge_check_field(L, p_index, end);
+                r_value.set_end(end);
+                return true;
+            }
+        }
+        return false;
+    }
+};
+
+template <> struct BridgeFields<Rect2> : BridgeBoxFields<Rect2, Vector2> {};
+template <> struct BridgeFields<Rect2i> : BridgeBoxFields<Rect2i, Vector2i> {};
+template <> struct BridgeFields<AABB> : BridgeBoxFields<AABB, Vector3> {};
+
+template <>
+struct BridgeFields<Plane> {
+    static bool get(lua_State *L, const Plane &p_value, int p_atom) {
+        switch (p_atom) {
+            case LuauBridge::ATOM_NORMAL: return bridge_push_field(L, p_value.normal);
+            case LuauBridge::ATOM_D: return bridge_push_field(L, p_value.d);
+            case LuauBridge::ATOM_X: return bridge_push_field(L, p_value.normal.x);
+            case LuauBridge::ATOM_Y: return bridge_push_field(L, p_value.normal.y);
+            case LuauBridge::ATOM_Z: return bridge_push_field(L, p_value.normal.z);
+        }
+        return false;
+    }
+
+    static bool set(lua_State *L, Plane &r_value, int p_atom, int p_index) {
+        switch (p_atom) {
+            case LuauBridge::ATOM_NORMAL: return bridge_check_field(L, p_index, r_value.normal);
+            case LuauBridge::ATOM_D: return bridge_check_field(L, p_index, r_value.d);
+            case LuauBridge::ATOM_X: return bridge_check_field(L, p_index, r_value.normal.x);
+            case LuauBridge::ATOM_Y: return bridge_check_field(L, p_index, r_value.normal.y);
+            case LuauBridge::ATOM_Z: return bridge_check_field(L, p_index, r_value.normal.z);
+        }
+        return false;
+    }
+};
+
+template <>
+struct BridgeFields<Transform2D> {
+    static bool get(lua_State *L, const Transform2D &p_value, int p_atom) {
+        switch (p_atom) {
+            case LuauBridge::ATOM_X: return bridge_push_field(L, p_value.columns[0]);
+            case LuauBridge::ATOM_Y: return bridge_push_field(L, p_value.columns[1]);
+            case LuauBridge::ATOM_ORIGIN: return bridge_push_field(L, p_value.columns[2]);
+        }
+        return false;
+    }
+
+    static bool set(lua_State *L, Transform2D &r_value, int p_atom, int p_index) {
+        switch (p_atom) {
+            case LuauBridge::ATOM_X: return bridge_check_field(L, p_index, r_value.columns[0]);
+            case LuauBridge::ATOM_Y: return bridge_check_field(L, p_index, r_value.columns[1]);
+            case LuauBridge::ATOM_ORIGIN: return bridge_check_field(L, p_index, r_value.columns[2]);
+        }
+        return false;
+    }
+};
+
+// Basis.x/y/z are columns, matching the Variant properties
+template <>
+struct BridgeFields<Basis> {
+    static bool get(lua_State *L, const Basis &p_value, int p_atom) {
+        if (p_atom >= LuauBridge::ATOM_X && p_atom <= LuauBridge::ATOM_Z) {
+            return bridge_push_field(L, p_value.get_column(p_atom - LuauBridge::ATOM_X));
+        }
+        return false;
+    }
+
+    static bool set(lua_State *L, Basis &r_value, int p_atom, int p_index) {
+        if (p_atom >= LuauBridge::ATOM_X && p_atom <= LuauBridge::ATOM_Z) {
+            Vector3 column;
+            bridge_check_field(L, p_index, column);
+            r_value.set_column(p_atom - LuauBridge::ATOM_X, column);
+            return true;
+        }
+        return false;
+    }
 };
 
+template <>
+struct BridgeFields<Transform3D> {
+    static bool get(lua_State *L, const Transform3D &p_value, int p_atom) {
+        switch (p_atom) {
+            case LuauBridge::ATOM_BASIS: return bridge_push_field(L, p_value.basis);
+            case LuauBridge::ATOM_ORIGIN: return bridge_push_field(L, p_value.origin);
+        }
+        return false;
+    }
+
+    static bool set(lua_State *L, Transform3D &r_value, int p_atom, int p_index) {
+        switch (p_atom) {
+            case LuauBridge::ATOM_BASIS: return bridge_check_field(L, p_index, r_value.basis);
+            case LuauBridge::ATOM_ORIGIN: return bridge_check_field(L, p_index, r_value.origin);
+        }
+        return false;
+    }
+};
 
 //MARK: VariantBridge
 template<class GDV, bool __eq = true>
 class VariantBridge {
 public:
     static const char* variant_name;
+    static constexpr int variant_tag = GetTypeInfo<GDV>::VARIANT_TYPE;
 
     static GDV* push_new(lua_State* L) {
-        GDV* ud = (GDV*)lua_newuserdata(L, sizeof(GDV));
+        GDV* ud = (GDV*)lua_newuserdatataggedwithmetatable(L, sizeof(GDV), variant_tag);
         new (ud) GDV();
 
-        luaL_getmetatable(L, variant_name);
-        lua_setmetatable(L, -2);
-
         return ud;
     }
 
     static GDV* push_from(lua_State* L, const Variant& v) {
-        GDV* ud = (GDV*)lua_newuserdata(L, sizeof(GDV));
+        GDV* ud = (GDV*)lua_newuserdatataggedwithmetatable(L, sizeof(GDV), variant_tag);
         new (ud) GDV(v.operator GDV());
 
-        luaL_getmetatable(L, variant_name);
-        lua_setmetatable(L, -2);
-
         return ud;
     }
 
     static GDV& get_object(lua_State* L, unsigned int index) {
-        void *ud = LuauBridge::luaL_checkudata(L, index, variant_name);
+        void *ud = lua_touserdatatagged(L, index, variant_tag);
 
         if (!ud) {
-            luaL_error(L, "Invalid userdata");
+            luaL_typeerror(L, index, variant_name);
         }
 
         return *reinterpret_cast<GDV*>(ud);
     }
 
+    static Variant to_variant(lua_State* L, int index) {
+        return *reinterpret_cast<GDV*>(lua_touserdata(L, index));
+    }
+
     static void register_variant(lua_State* L);
 
 
@@ -72,9 +508,8 @@ public:
     static int on_newindex(lua_State* L, const GDV& object, const char* key);
     static int on_call(lua_State* L, bool& is_valid);
 
-    static int on_gc(lua_State *L) {
-		get_object(L, 1).~GDV();
-		return 0;
+    static void on_destroy(lua_State *L, void *p_ud) {
+		reinterpret_cast<GDV*>(p_ud)->~GDV();
 	}
 
 	static int on_tostring(lua_State *L) {
@@ -84,6 +519,20 @@ public:
 	}
 
 	static int on_index(lua_State *L) {
+        int atom = -1;
+        if (lua_tostringatom(L, 2, &atom) && atom >= 0) {
+            if (BridgeFields<GDV>::get(L, get_object(L, 1), atom)) {
+                return 1;
+            }
+        }
+
+        // Dictionary keys shadow methods (`d.size`), so its cache is only tried once the key lookup misses
+        if constexpr (!std::is_same<GDV, Dictionary>::value) {
+            if (lua_type(L, 2) == LUA_TSTRING && push_cached_method(L)) {
+                return 1;
+            }
+        }
+
         Variant obj = get_object(L, 1);
 
 		const char* key = lua_tostring(L, 2);
@@ -94,6 +543,12 @@ public:
 
         // WARN_PRINT(vformat("value (%s) is: %s (%s) valid: %s", prop_name, value, value.get_type_name(value.get_type()), (valid? "true" : "false")));
         if (!valid) {
+            if constexpr (std::is_same<GDV, Dictionary>::value) {
+                if (lua_type(L, 2) == LUA_TSTRING && push_cached_method(L)) {
+                    return 1;
+                }
+            }
+
             lua_getglobal(L, variant_name);
             lua_pushstring(L, key);
             lua_rawget(L, -2);
@@ -112,72 +567,8 @@ public:
         if (value.get_type() == Variant::CALLABLE) {
             // obj.prop_name is a method
 
-            lua_pushstring(L, key);
-            lua_pushcclosure(L, [](lua_State *L) -> int {
-                const char* key = lua_tostring(L, lua_upvalueindex(1));
-                Variant obj = get_object(L, 1);
-
-                StringName method_name(key);
-
-                if (!obj.has_method(method_name)) {
-                    luaL_error(L, vformat("Object does not have method: %s", method_name).utf8().get_data());
-                    return 1;
-                }
-
-                const int argc = lua_gettop(L) -1;
-                Variant* var_buffer = (Variant*)memalloc(sizeof(Variant) * argc);
-                const Variant** ptrs = (const Variant**)memalloc(sizeof(Variant*) * argc);
-                for (int i = 0; i < argc; i++) {
-                    Variant v = LuauBridge::get_variant(L, i + 2);
-                    new (&var_buffer[i]) Variant(v);
-                    ptrs[i] = &var_buffer[i];
-                }
-
-                Variant result;
-                GDExtensionCallError error;
-                obj.callp(method_name, ptrs, argc, result, error);
-                if (error.error != GDEXTENSION_CALL_OK) {
-                    GDExtensionCallErrorType error_type = error.error;
-                    switch (error_type) {
-                        case GDEXTENSION_CALL_ERROR_INVALID_METHOD: {
-                            luaL_error(L, vformat("Object does not have method: %s", method_name).utf8().get_data());
-                            break;
-                        };
-                        case GDEXTENSION_CALL_ERROR_INVALID_ARGUMENT: {
-                            luaL_error(L, vformat("Invalid argument for method: %s", method_name).utf8().get_data());
-                            break;
-                        };
-                        case GDEXTENSION_CALL_ERROR_TOO_FEW_ARGUMENTS: {
-                            luaL_error(L, vformat("Too few arguments for method: %s, expected at least %s, got %s", method_name, error.argument, argc).utf8().get_data());
-                            break;
-                        };
-                        case GDEXTENSION_CALL_ERROR_TOO_MANY_ARGUMENTS: {
-                            luaL_error(L, vformat("Too many arguments for method: %s, expected %s, got %s", method_name, error.argument, argc).utf8().get_data());
-                            break;
-                        };
-                        case GDEXTENSION_CALL_ERROR_METHOD_NOT_CONST: {
-                            luaL_error(L, vformat("Method is not const: %s", method_name).utf8().get_data());
-                            break;
-                        };
-                        default: {
-                            luaL_error(L, vformat("Failed to call method(%s), Unkown error.", method_name).utf8().get_data());
-                            break;
-                        };
-                    }
-                    
-                    return 1;
-                }
-                LuauBridge::push_variant(L, result);
-
-                // Free the memory
-                for (int i = 0; i < argc; i++) {
-                    var_buffer[i].~Variant();
-                }
-                memfree(var_buffer);
-                memfree(ptrs);
-
-                return 1;
-            }, key, 1);
+            push_method_name(L, prop_name);
+            lua_pushcclosure(L, on_method_call, key, 1);
 
             return 1;
 
@@ -191,7 +582,148 @@ public:
         return on_index(L, obj, key);
 	}
 
+    // Builtin methods resolve once per VM and type into a C closure, cached in the
+    // table that is __index's upvalue; later lookups are a single rawget.
+    static bool push_cached_method(lua_State *L) {
+        lua_pushvalue(L, 2);
+        lua_rawget(L, lua_upvalueindex(1));
+        if (lua_isfunction(L, -1)) {
+            return true;
+        }
+        lua_pop(L, 1);
+
+        // Object methods depend on the class, not the bridge type
+        if constexpr (std::is_same<GDV, Object *>::value) {
+            return false;
+        } else {
+            const char *key = lua_tostring(L, 2);
+            StringName method(key);
+            if (!Variant(get_object(L, 1)).has_method(method)) {
+                return false;
+            }
+
+            LuauBridge::MethodBinding *binding = push_method_name(L, method);
+            LuauBridge::resolve_builtin_method(Variant::Type(variant_tag), key, binding->builtin);
+            lua_pushcclosure(L, on_method_call, key, 1);
+
+            lua_pushvalue(L, 2);
+            lua_pushvalue(L, -2);
+            lua_rawset(L, lua_upvalueindex(1));
+            return true;
+        }
+    }
+
+    static LuauBridge::MethodBinding *push_method_name(lua_State *L, const StringName &p_method) {
+        LuauBridge::MethodBinding *binding = (LuauBridge::MethodBinding *)lua_newuserdatatagged(L, sizeof(LuauBridge::MethodBinding), LuauBridge::UDTAG_METHOD_NAME);
+        new (binding) LuauBridge::MethodBinding();
+        binding->name = p_method;
+        return binding;
+    }
+
+    static constexpr int METHOD_STACK_ARGS = 8;
+
+    // Upvalue 1 is the MethodBinding. Exact signature matches are ptrcalls on the userdata
+    // itself; the rest go through callp with arguments up to METHOD_STACK_ARGS on the C stack.
+    static int on_method_call(lua_State *L) {
+        const LuauBridge::MethodBinding &binding = *(const LuauBridge::MethodBinding *)lua_touserdata(L, lua_upvalueindex(1));
+
+        if constexpr (std::is_same<GDV, Vector3>::value) {
+            // Native vectors are values, so the method works on a copy
+            if (lua_isvector(L, 1)) {
+                const float *v = lua_tovector(L, 1);
+                Vector3 object(v[0], v[1], v[2]);
+                return call_method(L, binding, object);
+            }
+        }
+
+        return call_method(L, binding, get_object(L, 1));
+    }
+
+    static int call_method(lua_State *L, const LuauBridge::MethodBinding &binding, GDV &object) {
+        const StringName &method_name = binding.name;
+
+        const int argc = lua_gettop(L) - 1;
+
+        if (binding.builtin.call && argc == binding.builtin.arg_count) {
+            int results = LuauBridge::call_builtin_method(L, binding.builtin, &object, 2, argc);
+            if (results >= 0) {
+                return results;
+            }
+        }
+
+        Variant obj = object;
+
+        Variant stack_args[METHOD_STACK_ARGS];
+        const Variant *stack_ptrs[METHOD_STACK_ARGS];
+        LocalVector<Variant> heap_args;
+        LocalVector<const Variant *> heap_ptrs;
+
+        Variant *args = stack_args;
+        const Variant **ptrs = stack_ptrs;
+        if (argc > METHOD_STACK_ARGS) {
+            heap_args.resize(argc);
+            heap_ptrs.resize(argc);
+            args = heap_args.ptr();
+            ptrs = heap_ptrs.ptr();
+        }
+
+        for (int i = 0; i < argc; i++) {
+            args[i] = LuauBridge::get_variant(L, i + 2);
+            ptrs[i] = &args[i];
+        }
+
+        Variant result;
+        GDExtensionCallError error;
+        obj.callp(method_name, ptrs, argc, result, error);
+        if (error.error != GDEXTENSION_CALL_OK) {
+            switch (error.error) {
+                case GDEXTENSION_CALL_ERROR_INVALID_METHOD: {
+                    luaL_error(L, vformat("Object does not have method: %s", method_name).utf8().get_data());
+                    break;
+                };
+                case GDEXTENSION_CALL_ERROR_INVALID_ARGUMENT: {
+                    luaL_error(L, vformat("Invalid argument for method: %s", method_name).utf8().get_data());
+                    break;
+                };
+                case GDEXTENSION_CALL_ERROR_TOO_FEW_ARGUMENTS: {
+                    luaL_error(L, vformat("Too few arguments for method: %s, expected at least %s, got %s", method_name, error.argument, argc).utf8().get_data());
+                    break;
+                };
+                case GDEXTENSION_CALL_ERROR_TOO_MANY_ARGUMENTS: {
+                    luaL_error(L, vformat("Too many arguments for method: %s, expected %s, got %s", method_name, error.argument, argc).utf8().get_data());
+                    break;
+                };
+                case GDEXTENSION_CALL_ERROR_METHOD_NOT_CONST: {
+                    luaL_error(L, vformat("Method is not const: %s", method_name).utf8().get_data());
+                    break;
+                };
+                default: {
+                    luaL_error(L, vformat("Failed to call method(%s), Unkown error.", method_name).utf8().get_data());
+                    break;
+                };
+            }
+
+            return 1;
+        }
+
+        // Mutating methods (push_back, resize, ...) changed the copy; store it back
+        if constexpr (!std::is_trivially_destructible<GDV>::value) {
+            object = obj.operator GDV();
+        }
+
+        LuauBridge::push_variant(L, result);
+        return 1;
+    }
+
 	static int on_newindex(lua_State *L) {
+        int atom = -1;
+        if (lua_tostringatom(L, 2, &atom) && atom >= 0) {
+            // Written in place; no Variant round trip
+            if (BridgeFields<GDV>::set(L, get_object(L, 1), atom, 3)) {
+                return 0;
+            }
+        }
+
         Variant obj = get_object(L, 1);
 		const char* key = lua_tostring(L, 2);
         Variant value = LuauBridge::get_variant(L, 3);
@@ -244,117 +776,52 @@ public:
     }
 
     static int on_eq(lua_State *L) {
-        Variant v1 = LuauBridge::get_variant(L, 1);
-        Variant v2 = LuauBridge::get_variant(L, 2);
-
-        Variant result;
-        bool valid;
-        Variant::evaluate(Variant::Operator::OP_EQUAL, v1, v2, result, valid);
-
-        if (!valid) {
-            luaL_error(L, "No equality operator for types: %s and %s", Variant::get_type_name(v1.get_type()), Variant::get_type_name(v2.get_type()));
-            return 1;
-        }
-        LuauBridge::push_variant(L, result);
-            
-        return 1;
+        return on_operator<Variant::OP_EQUAL>(L, "equality");
     }
 
     static int on_add(lua_State *L) {
-        Variant v1 = LuauBridge::get_variant(L, 1);
-        Variant v2 = LuauBridge::get_variant(L, 2);
-
-        Variant result;
-        bool valid;
-        Variant::evaluate(Variant::Operator::OP_ADD, v1, v2, result, valid);
-
-        if (!valid) {
-            luaL_error(L, "No addition operator for types: %s and %s", Variant::get_type_name(v1.get_type()), Variant::get_type_name(v2.get_type()));
-            return 1;
-        }
-        LuauBridge::push_variant(L, result);
-            
-        return 1;
+        return on_operator<Variant::OP_ADD>(L, "addition");
     }
 
     static int on_sub(lua_State *L) {
-        Variant v1 = LuauBridge::get_variant(L, 1);
-        Variant v2 = LuauBridge::get_variant(L, 2);
-
-        Variant result;
-        bool valid;
-        Variant::evaluate(Variant::Operator::OP_SUBTRACT, v1, v2, result, valid);
-
-        if (!valid) {
-            luaL_error(L, "No subtraction operator for types: %s and %s", Variant::get_type_name(v1.get_type()), Variant::get_type_name(v2.get_type()));
-            return 1;
-        }
-        LuauBridge::push_variant(L, result);
-            
-        return 1;
+        return on_operator<Variant::OP_SUBTRACT>(L, "subtraction");
     }
 
     static int on_mul(lua_State *L) {
-        Variant v1 = LuauBridge::get_variant(L, 1);
-        Variant v2 = LuauBridge::get_variant(L, 2);
-
-        Variant result;
-        bool valid;
-        Variant::evaluate(Variant::Operator::OP_MULTIPLY, v1, v2, result, valid);
-
-        if (!valid) {
-            luaL_error(L, "No multiplication operator for types: %s and %s", Variant::get_type_name(v1.get_type()), Variant::get_type_name(v2.get_type()));
-            return 1;
-        }
-        LuauBridge::push_variant(L, result);
-            
-        return 1;
+        return on_operator<Variant::OP_MULTIPLY>(L, "multiplication");
     }
 
     static int on_div(lua_State *L) {
-        Variant v1 = LuauBridge::get_variant(L, 1);
-        Variant v2 = LuauBridge::get_variant(L, 2);
-
-        Variant result;
-        bool valid;
-        Variant::evaluate(Variant::Operator::OP_DIVIDE, v1, v2, result, valid);
-
-        if (!valid) {
-            luaL_error(L, "No division operator for types: %s and %s", Variant::get_type_name(v1.get_type()), Variant::get_type_name(v2.get_type()));
-            return 1;
-        }
-        LuauBridge::push_variant(L, result);
-            
-        return 1;
+        return on_operator<Variant::OP_DIVIDE>(L, "division");
     }
 
     static int on_mod(lua_State *L) {
-        Variant v1 = LuauBridge::get_variant(L, 1);
-        Variant v2 = LuauBridge::get_variant(L, 2);
+        return on_operator<Variant::OP_MODULE>(L, "modulo");
+    }
 
-        Variant result;
-        bool valid;
-        Variant::evaluate(Variant::Operator::OP_MODULE, v1, v2, result, valid);
+    static int on_pow(lua_State *L) {
+        return on_operator<Variant::OP_POWER>(L, "power");
+    }
 
-        if (!valid) {
-            luaL_error(L, "No modulo operator for types: %s and %s", Variant::get_type_name(v1.get_type()), Variant::get_type_name(v2.get_type()));
-            return 1;
+    // Typed fast path first; Variant::evaluate handles every other operand pair.
+    template <Variant::Operator OP>
+    static int on_operator(lua_State *L, const char *p_name) {
+        if constexpr (bridge_list_has<GDV, BridgeMathTypes>::value) {
+            if (bridge_fast_operator<OP, GDV>(L)) {
+                return 1;
+            }
         }
-        LuauBridge::push_variant(L, result);
-            
-        return 1;
-    }
 
-    static int on_pow(lua_State *L) {
         Variant v1 = LuauBridge::get_variant(L, 1);
         Variant v2 = LuauBridge::get_variant(L, 2);
 
         Variant result;
         bool valid;
-        Variant::evaluate(Variant::Operator::OP_POWER, v1, v2, result, valid);
+        Variant::evaluate(OP, v1, v2, result, valid);
 
         if (!valid) {
-            luaL_error(L, "No power operator for types: %s and %s", Variant::get_type_name(v1.get_type()), Variant::get_type_name(v2.get_type()));
+            luaL_error(L, "No %s operator for types: %s and %s", p_name,
+                    Variant::get_type_name(v1.get_type()).utf8().get_data(), Variant::get_type_name(v2.get_type()).utf8().get_data());
             return 1;
         }
         LuauBridge::push_variant(L, result);
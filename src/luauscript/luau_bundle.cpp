@@ -0,0 +1,126 @@
+#include "luau_bundle.h"
+
+#include <godot_cpp/classes/file_access.hpp>
+#include <godot_cpp/variant/utility_functions.hpp>
+
+#include <cstring>
+
+using namespace godot;
+
+static constexpr uint8_t BUNDLE_MAGIC[4] = { 'L', 'U', 'B', 'N' };
+static constexpr int64_t HEADER_SIZE = 16;
+
+PackedByteArray LuauBundle::pack(const PackedStringArray &p_paths, const Vector<PackedByteArray> &p_blobs, bool p_compress) {
+    ERR_FAIL_COND_V(p_paths.size() != p_blobs.size(), PackedByteArray());
+
+    Vector<PackedByteArray> blobs;
+    Vector<CharString> paths;
+    int64_t index_size = 0;
+
+    for (int i = 0; i < p_paths.size(); i++) {
+        paths.push_back(p_paths[i].utf8());
+        blobs.push_back(p_compress ? p_blobs[i].compress(FileAccess::COMPRESSION_ZSTD) : p_blobs[i]);
+        index_size += 4 + paths[i].length() + 8 + 4 + 4;
+    }
+
+    PackedByteArray out;
+    out.resize(HEADER_SIZE + index_size);
+
+    memcpy(out.ptrw(), BUNDLE_MAGIC, 4);
+    out.encode_u32(4, FORMAT_VERSION);
+    out.encode_u32(8, p_compress ? FLAG_ZSTD : 0);
+    out.encode_u32(12, p_paths.size());
+
+    int64_t pos = HEADER_SIZE;
+    uint64_t offset = 0;
+
+    for (int i = 0; i < paths.size(); i++) {
+        out.encode_u32(pos, paths[i].length());
+        memcpy(out.ptrw() + pos + 4, paths[i].get_data(), paths[i].length());
+        pos += 4 + paths[i].length();
+
+        out.encode_u64(pos, offset);
+        out.encode_u32(pos + 8, blobs[i].size());
+        out.encode_u32(pos + 12, p_blobs[i].size());
+        pos += 16;
+
+        offset += blobs[i].size();
+    }
+
+    for (const PackedByteArray &blob : blobs) {
+        out.append_array(blob);
+    }
+
+    return out;
+}
+
+bool LuauBundle::open(const String &p_path) {
+    if (opened) {
+        return is_open();
+    }
+    opened = true;
+
+    if (!FileAccess::file_exists(p_path)) {
+        return false;
+    }
+
+    // One read for the whole bundle; pack files are not mappable from an extension
+    data = FileAccess::get_file_as_bytes(p_path);
+
+    ERR_FAIL_COND_V_MSG(data.size() < HEADER_SIZE || memcmp(data.ptr(), BUNDLE_MAGIC, 4) != 0, false,
+            vformat("Invalid Luau bundle: %s", p_path));
+    ERR_FAIL_COND_V_MSG(data.decode_u32(4) != FORMAT_VERSION, false,
+            vformat("Unsupported Luau bundle version %d: %s", data.decode_u32(4), p_path));
+
+    flags = data.decode_u32(8);
+    uint32_t count = data.decode_u32(12);
+
+    int64_t pos = HEADER_SIZE;
+    for (uint32_t i = 0; i < count; i++) {
+        ERR_FAIL_COND_V_MSG(pos + 4 > data.size(), false, vformat("Truncated Luau bundle: %s", p_path));
+        uint32_t path_len = data.decode_u32(pos);
+        pos += 4;
+
+        ERR_FAIL_COND_V_MSG(pos + path_len + 16 > data.size(), false, vformat("Truncated Luau bundle: %s", p_path));
+        String path = String::utf8((const char *)data.ptr() + pos, path_len);
+        pos += path_len;
+
+        Entry entry;
+        entry.offset = data.decode_u64(pos);
+        entry.size = data.decode_u32(pos + 8);
+        entry.raw_size = data.decode_u32(pos + 12);
+        pos += 16;
+
+        index.insert(path, entry);
+    }
+
+    blob_start = pos;
+
+    print_verbose(vformat("Luau: opened bundle %s with %d scripts", p_path, int(index.size())));
+    return true;
+}
+
+Dictionary LuauBundle::get(const String &p_path) const {
+    const Entry *entry = index.getptr(p_path);
+    if (!entry) {
+        return Dictionary();
+    }
+
+    int64_t begin = blob_start + entry->offset;
+    ERR_FAIL_COND_V_MSG(begin + entry->size > data.size(), Dictionary(), vformat("Luau bundle entry out of range: %s", p_path));
+
+    PackedByteArray blob = data.slice(begin, begin + entry->size);
+    if (flags & FLAG_ZSTD) {
+        blob = blob.decompress(entry->raw_size, FileAccess::COMPRESSION_ZSTD);
+    }
+
+    return UtilityFunctions::bytes_to_var(blob);
+}
+
+PackedStringArray LuauBundle::get_paths() const {
+    PackedStringArray paths;
+    for (const KeyValue<String, Entry> &E : index) {
+        paths.push_back(E.key);
+    }
+    return paths;
+}
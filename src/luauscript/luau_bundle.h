@@ -0,0 +1,58 @@
+#ifndef LUAU_BUNDLE_H
+#define LUAU_BUNDLE_H
+
+#include <godot_cpp/templates/hash_map.hpp>
+#include <godot_cpp/templates/vector.hpp>
+#include <godot_cpp/variant/dictionary.hpp>
+#include <godot_cpp/variant/packed_byte_array.hpp>
+#include <godot_cpp/variant/packed_string_array.hpp>
+#include <godot_cpp/variant/string.hpp>
+
+#include <cstdint>
+
+namespace godot {
+
+//MARK: LuauBundle
+// Precompiled scripts written at export time. Layout, little endian:
+//   header   magic "LUBN", u32 version, u32 flags, u32 entry count
+//   index    per entry: u32 path length, UTF-8 path, u64 blob offset, u32 size, u32 raw size
+//   blobs    var_to_bytes of the same Dictionary the disk cache stores, zstd'd with FLAG_ZSTD
+// The whole file is read with one sequential read; blobs are decoded on demand.
+class LuauBundle {
+public:
+    static constexpr const char *BUNDLE_PATH = "res://.luau/scripts.lubn";
+    static constexpr uint32_t FORMAT_VERSION = 1;
+
+    enum Flags : uint32_t {
+        FLAG_ZSTD = 1 << 0,
+    };
+
+private:
+    struct Entry {
+        uint64_t offset = 0;
+        uint32_t size = 0;
+        uint32_t raw_size = 0;
+    };
+
+    HashMap<String, Entry> index;
+    PackedByteArray data;
+    uint64_t blob_start = 0;
+    uint32_t flags = 0;
+    bool opened = false;
+
+public:
+    // Serializes p_blobs[i] as the entry for p_paths[i].
+    static PackedByteArray pack(const PackedStringArray &p_paths, const Vector<PackedByteArray> &p_blobs, bool p_compress);
+
+    // Loads the bundle at p_path once; later calls are no-ops. Returns false if there is none.
+    bool open(const String &p_path = BUNDLE_PATH);
+    bool is_open() const { return opened && !index.is_empty(); }
+
+    bool has(const String &p_path) const { return index.has(p_path); }
+    Dictionary get(const String &p_path) const;
+    PackedStringArray get_paths() const;
+};
+
+}; // namespace godot
+
+#endif
@@ -1,9 +1,23 @@
 #include "luau_cache.h"
 
+#include <godot_cpp/classes/dir_access.hpp>
+#include <godot_cpp/classes/file_access.hpp>
 #include <godot_cpp/classes/global_constants.hpp>
 #include <godot_cpp/classes/ref.hpp>
+#include <godot_cpp/classes/worker_thread_pool.hpp>
+#include <godot_cpp/variant/callable_method_pointer.hpp>
+#include <godot_cpp/variant/utility_functions.hpp>
 
+#include <algorithm>
+
+#include <Luau/Bytecode.h>
+#include <Luau/Compiler.h>
+
+#include "nobind.h"
+#include "luau_bundle.h"
+#include "luau_engine.h"
 #include "luau_script.h"
+#include "luau_version.gen.h"
 
 using namespace godot;
 
@@ -11,50 +25,968 @@ LuauCache *LuauCache::singleton = nullptr;
 
 Ref<LuauScript> LuauCache::get_script(const String &p_path, Error &r_error, bool p_ignore_cache, LuauScript::LoadStage p_stage) {
 	String path = p_path.simplify_path();
+	Shard &shard = get_shard(path);
+	uint64_t thread_id = nobind::OS::get_singleton()->get_thread_caller_id();
 
 	Ref<LuauScript> script;
+	InFlight *pending = nullptr;
+	bool needs_init = false;
 	r_error = OK;
 
-	HashMap<String, Ref<LuauScript>>::ConstIterator E = cache.find(path);
-	if (E) {
-		script = E->value;
+	while (!pending) {
+		InFlight *waiting = nullptr;
+
+		{
+			MutexLock lock(*shard.mutex.ptr());
+
+			HashMap<String, Ref<LuauScript>>::ConstIterator E = shard.scripts.find(path);
+			if (E) {
+				script = E->value;
+			}
+
+			InFlight **F = shard.in_flight.getptr(path);
+			if (F) {
+				// A script reaching itself through its own load (e.g. an `extends` cycle) gets the partial script.
+				if ((*F)->thread_id == thread_id) {
+					return script;
+				}
+
+				// Likewise when two threads' loads need each other: the one that would close the cycle doesn't wait.
+				if (!begin_wait(thread_id, (*F)->thread_id)) {
+					return script;
+				}
+
+				waiting = *F;
+				waiting->waiters++;
+			} else {
+				shard.last_used[path] = use_clock.increment();
+
+				if (script.is_valid() && !p_ignore_cache && script->load_stage >= p_stage) {
+					stats.script_hits.increment();
+					return script;
+				}
+
+				stats.script_misses.increment();
+				needs_init = script.is_null();
+				if (needs_init) {
+					script.instantiate();
+					// Set cache before `load` to prevent infinite recursion inside.
+					shard.scripts[path] = script;
+				}
 
-		if (!p_ignore_cache) {
-			script->load(p_stage);
-			return script;
+				pending = memnew(InFlight);
+				pending->done.instantiate();
+				pending->thread_id = thread_id;
+				shard.in_flight.insert(path, pending);
+			}
 		}
-	}
 
-	bool needs_init = script.is_null();
+		if (waiting) {
+			// Another thread is loading this path; share its result instead of compiling twice.
+			waiting->done->wait();
+			end_wait(thread_id);
 
-	if (needs_init) {
-		script.instantiate();
+			MutexLock lock(*shard.mutex.ptr());
+			r_error = waiting->error;
+			if (--waiting->waiters == 0) {
+				memdelete(waiting);
+			}
+
+			if (p_ignore_cache || r_error != OK) {
+				// The owner may have evicted or dropped the entry; don't resurrect it empty
+				const Ref<LuauScript> *loaded = shard.scripts.getptr(path);
+				return loaded ? *loaded : Ref<LuauScript>();
+			}
+		}
+	}
 
+	if (needs_init) {
 		// This is done for tests, as Godot is holding onto references to scripts for some reason.
 		// Shouldn't really have side effects, hopefully.
 		script->take_over_path(path);
+	}
+
+	r_error = load_script(script, path, p_ignore_cache || needs_init, p_stage);
+
+	Ref<Semaphore> done = pending->done;
+	int waiters;
+
+	{
+		MutexLock lock(*shard.mutex.ptr());
+		shard.in_flight.erase(path);
 
-		// Set cache before `load` to prevent infinite recursion inside.
-		cache[path] = script;
+		pending->error = r_error;
+		waiters = pending->waiters;
+		if (waiters == 0) {
+			memdelete(pending);
+		}
+	}
+
+	// The last waiter to wake frees `pending`, so only the local ref is used from here on.
+	for (int i = 0; i < waiters; i++) {
+		done->post();
+	}
+
+	if (needs_init) {
+		trim();
+	}
+
+	return script;
+}
+
+bool LuauCache::begin_wait(uint64_t p_thread_id, uint64_t p_owner_id) {
+	MutexLock lock(*wait_mutex.ptr());
+
+	// Follow what the owner is waiting on, and so on; reaching this thread means nobody would ever wake
+	for (uint64_t owner = p_owner_id;;) {
+		if (owner == p_thread_id) {
+			return false;
+		}
+
+		const uint64_t *next = waiting_on.getptr(owner);
+		if (!next) {
+			break;
+		}
+		owner = *next;
 	}
 
-	if (p_ignore_cache || needs_init) {
-		r_error = script->load_source_code(path);
+	waiting_on[p_thread_id] = p_owner_id;
+	return true;
+}
+
+void LuauCache::end_wait(uint64_t p_thread_id) {
+	MutexLock lock(*wait_mutex.ptr());
+	waiting_on.erase(p_thread_id);
+}
+
+Error LuauCache::load_script(const Ref<LuauScript> &p_script, const String &p_path, bool p_reload, LuauScript::LoadStage p_stage) {
+	if (!p_reload) {
+		return p_script->load(p_stage);
+	}
 
-		if (r_error != OK)
-			return script;
+	// Exported games load precompiled scripts from the bundle, without any source
+	if (restore_bundled(p_path, p_script.ptr())) {
+		return p_script->load(p_stage);
 	}
 
-	if (path.ends_with(".mod.lua")) {
+	Error err = p_script->load_source_code(p_path);
+	if (err != OK) {
+		return err;
+	}
+
+	if (p_path.ends_with(".mod.lua")) {
 		//script->_is_module = true;
 	}
 
-	script->load(p_stage, true);
+	return p_script->load(p_stage, true);
+}
 
-	return script;
+//MARK: Compiled cache
+String LuauCache::get_cache_dir() {
+	// The editor keeps it with the project's other generated data; exported games can only write to user://.
+	return nobind::Engine::get_singleton()->is_editor_hint() ? "res://.godot/luau_cache" : "user://luau_cache";
+}
+
+String LuauCache::get_cache_key(const String &p_source) {
+	return get_cache_key(p_source, LuauScript::get_compile_profile(), LuauScript::is_lean_load());
+}
+
+String LuauCache::get_cache_key(const String &p_source, const String &p_profile, bool p_lean) {
+	Luau::CompileOptions opts = LuauScript::get_compile_options(p_profile);
+
+	// Lean analysis leaves out editor-only metadata, so its entries can't serve a full load.
+	// The Luau and extension versions cover codegen and analysis changes the bytecode version doesn't.
+	String tag = vformat("v%d;luau%s;ext%s;lbc%d;types%d;%s;O%d;g%d;t%d;c%d;vec%s;lean%d",
+			CACHE_FORMAT_VERSION, LUAUGD_LUAU_VERSION, LUAUGD_EXTENSION_VERSION, LBC_VERSION_TARGET, LBC_TYPE_VERSION_TARGET, p_profile,
+			opts.optimizationLevel, opts.debugLevel, opts.typeInfoLevel, opts.coverageLevel,
+			opts.vectorCtor ? opts.vectorCtor : "", p_lean ? 1 : 0);
+
+	return (tag + "\n" + p_source).sha256_text();
+}
+
+void LuauCache::track_disk_key(const String &p_path, const String &p_key) {
+	if (p_path.is_empty()) {
+		return;
+	}
+
+	String stale;
+	{
+		MutexLock lock(*disk_mutex.ptr());
+
+		String *current = disk_keys.getptr(p_path);
+		if (current && *current == p_key) {
+			return;
+		}
+
+		disk_key_users[p_key]++;
+		if (current) {
+			int *users = disk_key_users.getptr(*current);
+			if (users && --(*users) == 0) {
+				disk_key_users.erase(*current);
+				stale = *current;
+			}
+			*current = p_key;
+		} else {
+			disk_keys.insert(p_path, p_key);
+		}
+	}
+
+	if (stale.is_empty()) {
+		return;
+	}
+
+	{
+		Shard &shard = get_shard(stale);
+		MutexLock lock(*shard.mutex.ptr());
+		shard.compiled.erase(stale);
+	}
+
+	String path = get_cache_dir().path_join(stale + ".luauc");
+	if (FileAccess::file_exists(path)) {
+		DirAccess::remove_absolute(path);
+	}
+}
+
+void LuauCache::prune_disk_cache() {
+	String dir = get_cache_dir();
+	if (max_disk_files <= 0 || !DirAccess::dir_exists_absolute(dir)) {
+		return;
+	}
+
+	PackedStringArray files = DirAccess::get_files_at(dir);
+	if (files.size() <= max_disk_files) {
+		return;
+	}
+
+	struct CacheFile {
+		String path;
+		uint64_t modified;
+	};
+
+	LocalVector<CacheFile> entries;
+	for (const String &file : files) {
+		if (file.get_extension() == "luauc") {
+			String path = dir.path_join(file);
+			entries.push_back({ path, FileAccess::get_modified_time(path) });
+		}
+	}
+
+	if (entries.size() <= uint32_t(max_disk_files)) {
+		return;
+	}
+
+	std::sort(entries.ptr(), entries.ptr() + entries.size(), [](const CacheFile &a, const CacheFile &b) {
+		return a.modified < b.modified;
+	});
+
+	uint32_t removed = entries.size() - max_disk_files;
+	for (uint32_t i = 0; i < removed; i++) {
+		DirAccess::remove_absolute(entries[i].path);
+	}
+
+	print_verbose(vformat("Luau: pruned %d stale files from %s", removed, dir));
+}
+
+static Dictionary property_to_dict(const GDClassProperty &p_prop) {
+	Dictionary dict;
+	dict["property"] = p_prop.property;
+	dict["getter"] = p_prop.getter;
+	dict["setter"] = p_prop.setter;
+	dict["default"] = p_prop.default_value;
+	return dict;
+}
+
+static GDProperty property_info_from_dict(const Dictionary &p_dict) {
+	GDProperty prop;
+	prop.type = GDExtensionVariantType(int(p_dict.get("type", 0)));
+	prop.usage = BitField<PropertyUsageFlags>(int64_t(p_dict.get("usage", PROPERTY_USAGE_DEFAULT)));
+	prop.name = p_dict.get("name", "");
+	prop.class_name = p_dict.get("class_name", StringName());
+	prop.hint = PropertyHint(int(p_dict.get("hint", 0)));
+	prop.hint_string = p_dict.get("hint_string", "");
+	return prop;
+}
+
+static GDClassProperty property_from_dict(const Dictionary &p_dict) {
+	GDClassProperty prop;
+	prop.property = property_info_from_dict(p_dict.get("property", Dictionary()));
+	prop.getter = p_dict.get("getter", StringName());
+	prop.setter = p_dict.get("setter", StringName());
+	prop.default_value = p_dict.get("default", Variant());
+	return prop;
+}
+
+static GDMethod method_from_dict(const Dictionary &p_dict) {
+	GDMethod method;
+	method.name = p_dict.get("name", "");
+	method.return_val = property_info_from_dict(p_dict.get("return", Dictionary()));
+	method.flags = BitField<MethodFlags>(int64_t(p_dict.get("flags", METHOD_FLAGS_DEFAULT)));
+
+	Array args = p_dict.get("args", Array());
+	for (int i = 0; i < args.size(); i++) {
+		method.arguments.push_back(property_info_from_dict(args[i]));
+	}
+
+	Array default_args = p_dict.get("default_args", Array());
+	for (int i = 0; i < default_args.size(); i++) {
+		method.default_arguments.push_back(default_args[i]);
+	}
+
+	return method;
+}
+
+Dictionary LuauCache::serialize_definition(const GDClassDefinition &p_def) {
+	Dictionary data;
+	data["name"] = p_def.name;
+	data["extends"] = p_def.extends;
+	data["icon_path"] = p_def.icon_path;
+	data["permissions"] = int(p_def.permissions);
+	data["is_tool"] = p_def.is_tool;
+
+	Array methods;
+	for (const KeyValue<StringName, GDMethod> &E : p_def.methods) {
+		methods.push_back(E.value);
+	}
+	data["methods"] = methods;
+
+	Array signals;
+	for (const KeyValue<StringName, GDMethod> &E : p_def.signals) {
+		Dictionary signal = E.value;
+		signal["key"] = E.key;
+		signals.push_back(signal);
+	}
+	data["signals"] = signals;
+
+	Array properties;
+	for (const GDClassProperty &prop : p_def.properties) {
+		properties.push_back(property_to_dict(prop));
+	}
+	data["properties"] = properties;
+
+	Array members;
+	for (const GDClassProperty &member : p_def.members) {
+		members.push_back(property_to_dict(member));
+	}
+	data["members"] = members;
+
+	Array rpcs;
+	for (const KeyValue<StringName, GDRpc> &E : p_def.rpcs) {
+		Dictionary rpc;
+		rpc["name"] = E.value.name;
+		rpc["rpc_mode"] = E.value.rpc_mode;
+		rpc["transfer_mode"] = E.value.transfer_mode;
+		rpc["call_local"] = E.value.call_local;
+		rpc["channel"] = E.value.channel;
+		rpcs.push_back(rpc);
+	}
+	data["rpcs"] = rpcs;
+
+	Dictionary constants;
+	for (const KeyValue<StringName, int> &E : p_def.constants) {
+		constants[E.key] = E.value;
+	}
+	data["constants"] = constants;
+
+	data["notifications"] = p_def.notifications;
+	data["dependencies"] = p_def.dependencies;
+
+	return data;
+}
+
+void LuauCache::deserialize_definition(const Dictionary &p_data, GDClassDefinition &r_def) {
+	r_def.name = p_data.get("name", "");
+	r_def.extends = p_data.get("extends", "RefCounted");
+	r_def.icon_path = p_data.get("icon_path", "");
+	r_def.permissions = ThreadPermissions(int(p_data.get("permissions", PERMISSION_BASE)));
+	r_def.is_tool = p_data.get("is_tool", false);
+
+	r_def.methods.clear();
+	Array methods = p_data.get("methods", Array());
+	for (int i = 0; i < methods.size(); i++) {
+		GDMethod method = method_from_dict(methods[i]);
+		r_def.methods[StringName(method.name)] = method;
+	}
+
+	r_def.signals.clear();
+	Array signals = p_data.get("signals", Array());
+	for (int i = 0; i < signals.size(); i++) {
+		Dictionary signal = signals[i];
+		r_def.signals[StringName(signal["key"])] = method_from_dict(signal);
+	}
+
+	r_def.properties.clear();
+	r_def.property_indices.clear();
+	Array properties = p_data.get("properties", Array());
+	for (int i = 0; i < properties.size(); i++) {
+		GDClassProperty prop = property_from_dict(properties[i]);
+		r_def.property_indices[StringName(prop.property.name)] = r_def.properties.size();
+		r_def.properties.push_back(prop);
+	}
+
+	r_def.members.clear();
+	r_def.member_indices.clear();
+	Array members = p_data.get("members", Array());
+	for (int i = 0; i < members.size(); i++) {
+		GDClassProperty member = property_from_dict(members[i]);
+		r_def.member_indices[StringName(member.property.name)] = r_def.members.size();
+		r_def.members.push_back(member);
+	}
+
+	r_def.rpcs.clear();
+	Array rpcs = p_data.get("rpcs", Array());
+	for (int i = 0; i < rpcs.size(); i++) {
+		Dictionary data = rpcs[i];
+		GDRpc rpc;
+		rpc.name = data.get("name", "");
+		rpc.rpc_mode = MultiplayerAPI::RPCMode(int(data.get("rpc_mode", 0)));
+		rpc.transfer_mode = MultiplayerPeer::TransferMode(int(data.get("transfer_mode", 0)));
+		rpc.call_local = data.get("call_local", false);
+		rpc.channel = data.get("channel", 0);
+		r_def.rpcs[StringName(rpc.name)] = rpc;
+	}
+
+	r_def.constants.clear();
+	Dictionary constants = p_data.get("constants", Dictionary());
+	Array constant_names = constants.keys();
+	for (int i = 0; i < constant_names.size(); i++) {
+		r_def.constants[StringName(constant_names[i])] = int(constants[constant_names[i]]);
+	}
+
+	r_def.notifications = p_data.get("notifications", PackedStringArray());
+
+	r_def.dependencies = p_data.get("dependencies", PackedStringArray());
+}
+
+bool LuauCache::entry_from_data(const Dictionary &p_data, CompiledEntry &r_entry) {
+	if (int(p_data.get("version", 0)) != CACHE_FORMAT_VERSION) {
+		return false;
+	}
+
+	r_entry.bytecode = p_data.get("bytecode", PackedByteArray());
+	r_entry.definition = p_data.get("definition", Dictionary());
+	r_entry.constants = p_data.get("constants", Dictionary());
+
+	return !r_entry.bytecode.is_empty();
+}
+
+Dictionary LuauCache::entry_to_data(const CompiledEntry &p_entry) {
+	Dictionary data;
+	data["version"] = CACHE_FORMAT_VERSION;
+	data["bytecode"] = p_entry.bytecode;
+	data["definition"] = p_entry.definition;
+	data["constants"] = p_entry.constants;
+	return data;
+}
+
+bool LuauCache::find_entry(const String &p_key, CompiledEntry &r_entry) {
+	Shard &shard = get_shard(p_key);
+
+	{
+		MutexLock lock(*shard.mutex.ptr());
+
+		HashMap<String, CompiledEntry>::ConstIterator E = shard.compiled.find(p_key);
+		if (E) {
+			r_entry = E->value;
+			return true;
+		}
+	}
+
+	String path = get_cache_dir().path_join(p_key + ".luauc");
+	if (!FileAccess::file_exists(path)) {
+		return false;
+	}
+
+	if (!entry_from_data(UtilityFunctions::bytes_to_var(FileAccess::get_file_as_bytes(path)), r_entry)) {
+		return false;
+	}
+
+	MutexLock lock(*shard.mutex.ptr());
+	shard.compiled.insert(p_key, r_entry);
+
+	return true;
+}
+
+bool LuauCache::has_entry(const String &p_key) {
+	Shard &shard = get_shard(p_key);
+
+	{
+		MutexLock lock(*shard.mutex.ptr());
+		if (shard.compiled.has(p_key)) {
+			return true;
+		}
+	}
+
+	return FileAccess::file_exists(get_cache_dir().path_join(p_key + ".luauc"));
+}
+
+bool LuauCache::restore(const String &p_key, LuauScript *p_script) {
+	CompiledEntry entry;
+	if (!find_entry(p_key, entry)) {
+		stats.bytecode_misses.increment();
+		return false;
+	}
+
+	stats.bytecode_hits.increment();
+	apply_entry(entry, p_script);
+	track_disk_key(p_script->get_path(), p_key);
+	return true;
+}
+
+bool LuauCache::open_bundle() {
+	MutexLock lock(*bundle_mutex.ptr());
+	return bundle.open();
+}
+
+bool LuauCache::restore_bundled(const String &p_path, LuauScript *p_script) {
+	if (!open_bundle() || !bundle.has(p_path)) {
+		return false;
+	}
+
+	CompiledEntry entry;
+	ERR_FAIL_COND_V_MSG(!entry_from_data(bundle.get(p_path), entry), false,
+			vformat("Corrupt Luau bundle entry: %s", p_path));
+
+	apply_entry(entry, p_script);
+	p_script->clear_main_functions();
+	p_script->load_stage = LuauScript::LOAD_ANALYSIS;
+
+	update_dependencies(p_path, p_script->definition.dependencies);
+
+	return true;
+}
+
+bool LuauCache::has_bundled(const String &p_path) {
+	return open_bundle() && bundle.has(p_path.simplify_path());
+}
+
+Dictionary LuauCache::get_compiled_data(const String &p_key) {
+	CompiledEntry entry;
+	return find_entry(p_key, entry) ? entry_to_data(entry) : Dictionary();
+}
+
+void LuauCache::apply_entry(const CompiledEntry &p_entry, LuauScript *p_script) {
+	p_script->bytecode = p_entry.bytecode;
+	deserialize_definition(p_entry.definition, p_script->definition);
+
+	// Scripts without @class take their name from the file, which may differ between identical sources.
+	if (p_entry.definition.get("name_from_path", false)) {
+		String path = p_script->get_path();
+		if (!path.is_empty()) {
+			p_script->definition.name = path.get_file().get_basename();
+		}
+	}
+
+	p_script->constants.clear();
+	Array names = p_entry.constants.keys();
+	for (int i = 0; i < names.size(); i++) {
+		p_script->constants[StringName(names[i])] = p_entry.constants[names[i]];
+	}
+}
+
+void LuauCache::store(const String &p_key, const LuauScript *p_script) {
+	LuauScript::CompiledScript result;
+	result.path = p_script->get_path();
+	result.bytecode = p_script->bytecode;
+	result.definition = p_script->definition;
+	result.constants = p_script->constants;
+
+	store_entry(p_key, result);
+}
+
+void LuauCache::store_entry(const String &p_key, const LuauScript::CompiledScript &p_script) {
+	if (p_key.is_empty() || p_script.bytecode.is_empty()) {
+		return;
+	}
+
+	track_disk_key(p_script.path, p_key);
+
+	Shard &shard = get_shard(p_key);
+	{
+		MutexLock lock(*shard.mutex.ptr());
+		if (shard.compiled.has(p_key)) {
+			return;
+		}
+	}
+
+	CompiledEntry entry;
+	entry.bytecode = p_script.bytecode;
+	entry.definition = serialize_definition(p_script.definition);
+	entry.definition["name_from_path"] = p_script.definition.name == p_script.path.get_file().get_basename();
+
+	for (const KeyValue<StringName, Variant> &E : p_script.constants) {
+		entry.constants[E.key] = E.value;
+	}
+
+	{
+		MutexLock lock(*shard.mutex.ptr());
+		if (shard.compiled.has(p_key)) {
+			return; // Another thread stored it first
+		}
+		shard.compiled.insert(p_key, entry);
+	}
+
+	String dir = get_cache_dir();
+	if (!DirAccess::dir_exists_absolute(dir) && DirAccess::make_dir_recursive_absolute(dir) != OK) {
+		return;
+	}
+
+	Ref<FileAccess> file = FileAccess::open(dir.path_join(p_key + ".luauc"), FileAccess::WRITE);
+	if (file.is_valid()) {
+		file->store_buffer(UtilityFunctions::var_to_bytes(entry_to_data(entry)));
+	}
+}
+
+//MARK: Batch compile
+bool LuauCache::is_loaded(const String &p_path, LuauScript::LoadStage p_stage) {
+	Shard &shard = get_shard(p_path);
+	MutexLock lock(*shard.mutex.ptr());
+
+	const Ref<LuauScript> *script = shard.scripts.getptr(p_path);
+	return script && !shard.in_flight.has(p_path) && (*script)->load_stage >= p_stage;
+}
+
+void LuauCache::compile_batch_job(BatchJob &r_job) {
+	r_job.result.source = FileAccess::get_file_as_string(r_job.result.path);
+	if (r_job.result.source.is_empty()) {
+		r_job.error = ERR_FILE_CANT_READ;
+		return;
+	}
+
+	r_job.key = get_cache_key(r_job.result.source, r_job.result.profile, r_job.result.lean);
+
+	if (singleton->has_entry(r_job.key)) {
+		r_job.cached = true;
+		return;
+	}
+
+	uint64_t start = nobind::Time::get_singleton()->get_ticks_usec();
+	r_job.error = LuauScript::compile_source(r_job.result);
+	singleton->record_compile(nobind::Time::get_singleton()->get_ticks_usec() - start);
+}
+
+Error LuauCache::compile_batch(const PackedStringArray &p_paths, bool p_publish, LuauScript::LoadStage p_stage, const String &p_profile) {
+	bool lean = LuauScript::is_lean_load();
+	String profile = p_profile.is_empty() ? LuauScript::get_compile_profile() : p_profile;
+
+	Ref<LuauCompileBatch> batch;
+	batch.instantiate();
+	LocalVector<BatchJob> &jobs = batch->jobs;
+	PackedStringArray publish;
+	for (const String &p : p_paths) {
+		String path = p.simplify_path();
+
+		if (p_publish) {
+			// Loaded scripts may have live instances; reloading them here would reset those
+			if (is_loaded(path, p_stage)) {
+				continue;
+			}
+
+			publish.push_back(path);
+
+			// Exports may ship without sources; get_script restores these from the bundle
+			if (has_bundled(path)) {
+				continue;
+			}
+		}
+
+		BatchJob job;
+		job.result.path = path;
+		job.result.lean = lean;
+		job.result.profile = profile;
+		jobs.push_back(job);
+	}
+
+	if (jobs.is_empty() && publish.is_empty()) {
+		return OK;
+	}
+
+	uint64_t start = nobind::Time::get_singleton()->get_ticks_usec();
+
+	if (!jobs.is_empty()) {
+		WorkerThreadPool *pool = WorkerThreadPool::get_singleton();
+		int64_t group = pool->add_group_task(callable_mp(batch.ptr(), &LuauCompileBatch::run_job), jobs.size(), -1, true, "Luau compile batch");
+		pool->wait_for_group_task_completion(group);
+	}
+
+	Error result = OK;
+	int compiled_count = 0;
+
+	for (BatchJob &job : jobs) {
+		if (job.error != OK) {
+			UtilityFunctions::printerr(vformat("Failed to compile Luau script: %s", job.result.path));
+			result = job.error;
+			continue;
+		}
+
+		if (!job.cached) {
+			store_entry(job.key, job.result);
+			compiled_count++;
+		}
+	}
+
+	// Loading now restores what the workers stored instead of compiling again
+	for (const String &path : publish) {
+		Error err;
+		get_script(path, err, false, p_stage);
+		if (err != OK) {
+			result = err;
+		}
+	}
+
+	print_verbose(vformat("Luau: compiled %d of %d scripts in %d ms", compiled_count, int(jobs.size()),
+			int((nobind::Time::get_singleton()->get_ticks_usec() - start) / 1000)));
+
+	return result;
+}
+
+//MARK: Preload
+Error LuauCache::preload(const PackedStringArray &p_paths) {
+	return compile_batch(p_paths, true, LuauScript::LOAD_FULL);
+}
+
+Error LuauCache::preload_manifest(const String &p_manifest) {
+	ERR_FAIL_COND_V_MSG(!FileAccess::file_exists(p_manifest), ERR_FILE_NOT_FOUND,
+			vformat("Luau preload manifest not found: %s", p_manifest));
+
+	PackedStringArray paths;
+	PackedStringArray lines = FileAccess::get_file_as_string(p_manifest).split("\n", false);
+	for (const String &line : lines) {
+		String path = line.strip_edges();
+		if (!path.is_empty() && !path.begins_with("#")) {
+			paths.push_back(path);
+		}
+	}
+
+	return preload(paths);
+}
+
+//MARK: Eviction
+uint64_t LuauCache::get_script_memory(const LuauScript *p_script) {
+	return p_script->bytecode.size() + p_script->source.length() * sizeof(char32_t);
+}
+
+bool LuauCache::is_evictable(const Ref<LuauScript> &p_script) {
+	// Only the cache's own ref may be left
+	if (p_script->get_reference_count() > 1 || !p_script->instances.is_empty()) {
+		return false;
+	}
+
+#ifdef TOOLS_ENABLED
+	if (!p_script->placeholders.is_empty()) {
+		return false;
+	}
+#endif // TOOLS_ENABLED
+
+	return true;
+}
+
+void LuauCache::trim() {
+	if (max_scripts <= 0 && max_memory == 0) {
+		return;
+	}
+
+	struct Candidate {
+		String path;
+		uint64_t last_used;
+		uint64_t memory;
+	};
+
+	LocalVector<Candidate> candidates;
+	int count = 0;
+	uint64_t memory = 0;
+
+	for (Shard &shard : shards) {
+		MutexLock lock(*shard.mutex.ptr());
+
+		for (KeyValue<String, Ref<LuauScript>> &E : shard.scripts) {
+			uint64_t script_memory = get_script_memory(E.value.ptr());
+			count++;
+			memory += script_memory;
+
+			if (!shard.in_flight.has(E.key) && is_evictable(E.value)) {
+				candidates.push_back({ E.key, shard.last_used.has(E.key) ? shard.last_used[E.key] : 0, script_memory });
+			}
+		}
+	}
+
+	auto within_limits = [&]() {
+		return (max_scripts <= 0 || count <= max_scripts) && (max_memory == 0 || memory <= max_memory);
+	};
+
+	if (within_limits()) {
+		return;
+	}
+
+	std::sort(candidates.ptr(), candidates.ptr() + candidates.size(), [](const Candidate &a, const Candidate &b) {
+		return a.last_used < b.last_used;
+	});
+
+	for (const Candidate &candidate : candidates) {
+		if (within_limits()) {
+			break;
+		}
+
+		Shard &shard = get_shard(candidate.path);
+		Ref<LuauScript> evicted;
+
+		{
+			MutexLock lock(*shard.mutex.ptr());
+
+			HashMap<String, Ref<LuauScript>>::Iterator E = shard.scripts.find(candidate.path);
+			if (!E || shard.in_flight.has(candidate.path) || !is_evictable(E->value)) {
+				continue; // Picked up again since the scan
+			}
+
+			evicted = E->value;
+			shard.scripts.remove(E);
+			shard.last_used.erase(candidate.path);
+		}
+
+		if (!evicted->compiled_key.is_empty()) {
+			Shard &entry_shard = get_shard(evicted->compiled_key);
+			MutexLock lock(*entry_shard.mutex.ptr());
+			entry_shard.compiled.erase(evicted->compiled_key);
+		}
+
+		count--;
+		memory -= candidate.memory;
+		stats.evictions.increment();
+	}
+}
+
+//MARK: Stats
+void LuauCache::record_compile(uint64_t p_usec) {
+	stats.compiles.increment();
+	stats.compile_usec.add(p_usec);
+}
+
+Dictionary LuauCache::get_stats() const {
+	int count = 0;
+	for (const Shard &shard : shards) {
+		MutexLock lock(*shard.mutex.ptr());
+		count += shard.scripts.size();
+	}
+
+	Dictionary result;
+	result["scripts"] = count;
+	result["script_hits"] = stats.script_hits.get();
+	result["script_misses"] = stats.script_misses.get();
+	result["bytecode_hits"] = stats.bytecode_hits.get();
+	result["bytecode_misses"] = stats.bytecode_misses.get();
+	result["compiles"] = stats.compiles.get();
+	result["compile_usec"] = stats.compile_usec.get();
+	result["evictions"] = stats.evictions.get();
+	return result;
+}
+
+//MARK: Dependencies
+void LuauCache::update_dependencies(const String &p_path, const PackedStringArray &p_dependencies) {
+	MutexLock lock(*graph_mutex.ptr());
+
+	PackedStringArray *old = dependencies.getptr(p_path);
+	if (old) {
+		for (const String &dependency : *old) {
+			HashSet<String> *users = dependents.getptr(dependency);
+			if (users) {
+				users->erase(p_path);
+			}
+		}
+	}
+
+	dependencies[p_path] = p_dependencies;
+	for (const String &dependency : p_dependencies) {
+		dependents[dependency].insert(p_path);
+	}
+}
+
+PackedStringArray LuauCache::get_dependencies(const String &p_path) const {
+	MutexLock lock(*graph_mutex.ptr());
+
+	const PackedStringArray *E = dependencies.getptr(p_path);
+	return E ? *E : PackedStringArray();
+}
+
+void LuauCache::sort_dependencies_first(const String &p_path, const HashSet<String> &p_affected, HashSet<String> &r_visited, PackedStringArray &r_order) const {
+	// Marking before recursing also breaks cycles
+	if (r_visited.has(p_path)) {
+		return;
+	}
+	r_visited.insert(p_path);
+
+	const PackedStringArray *E = dependencies.getptr(p_path);
+	if (E) {
+		for (const String &dependency : *E) {
+			if (p_affected.has(dependency)) {
+				sort_dependencies_first(dependency, p_affected, r_visited, r_order);
+			}
+		}
+	}
+
+	r_order.push_back(p_path);
+}
+
+PackedStringArray LuauCache::get_reload_order(const PackedStringArray &p_changed) const {
+	MutexLock lock(*graph_mutex.ptr());
+
+	HashSet<String> affected;
+	LocalVector<String> stack;
+	for (const String &path : p_changed) {
+		stack.push_back(path);
+	}
+
+	while (!stack.is_empty()) {
+		String path = stack[stack.size() - 1];
+		stack.resize(stack.size() - 1);
+
+		if (affected.has(path)) {
+			continue;
+		}
+		affected.insert(path);
+
+		const HashSet<String> *users = dependents.getptr(path);
+		if (users) {
+			for (const String &user : *users) {
+				stack.push_back(user);
+			}
+		}
+	}
+
+	HashSet<String> visited;
+	PackedStringArray order;
+	for (const String &path : affected) {
+		sort_dependencies_first(path, affected, visited, order);
+	}
+
+	return order;
+}
+
+Array LuauCache::get_scripts() const {
+	Array scripts;
+	for (const Shard &shard : shards) {
+		MutexLock lock(*shard.mutex.ptr());
+		for (const KeyValue<String, Ref<LuauScript>> &E : shard.scripts) {
+			scripts.push_back(E.value);
+		}
+	}
+	return scripts;
 }
 
 LuauCache::LuauCache() {
+	for (Shard &shard : shards) {
+		shard.mutex.instantiate();
+	}
+	bundle_mutex.instantiate();
+	graph_mutex.instantiate();
+	disk_mutex.instantiate();
+	wait_mutex.instantiate();
+
+	max_scripts = LuauEngine::get_project_setting("cache/max_scripts", 0);
+	max_memory = uint64_t(int64_t(LuauEngine::get_project_setting("cache/max_memory_kb", 0))) * 1024;
+	max_disk_files = LuauEngine::get_project_setting("cache/max_disk_files", 4096);
+
+	// Files left behind by edits made in earlier sessions are only caught here
+	prune_disk_cache();
+
 	if (!singleton)
 		singleton = this;
 }
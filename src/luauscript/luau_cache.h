@@ -2,26 +2,205 @@
 #define LUAU_CACHE_H
 
 #include "luau_script.h"
+#include "luau_bundle.h"
 
+#include <godot_cpp/classes/mutex.hpp>
 #include <godot_cpp/classes/ref.hpp>
+#include <godot_cpp/classes/ref_counted.hpp>
+#include <godot_cpp/core/class_db.hpp>
+#include <godot_cpp/classes/semaphore.hpp>
 #include <godot_cpp/templates/hash_map.hpp>
+#include <godot_cpp/templates/hash_set.hpp>
+#include <godot_cpp/templates/local_vector.hpp>
+#include <godot_cpp/templates/safe_refcount.hpp>
+#include <godot_cpp/variant/dictionary.hpp>
+#include <godot_cpp/variant/packed_byte_array.hpp>
+#include <godot_cpp/variant/packed_string_array.hpp>
 #include <godot_cpp/variant/string.hpp>
 
 namespace godot {
-	// Based on GDScriptCache
+	// Based on GDScriptCache. Safe to use from resource loader threads.
 	class LuauCache {
-		HashMap<String, Ref<LuauScript>> cache;
+		// Compiled results by cache key. Scripts restored from the same entry share
+		// one bytecode buffer (PackedByteArray is copy-on-write).
+		struct CompiledEntry {
+			PackedByteArray bytecode;
+			Dictionary definition;
+			Dictionary constants;
+		};
+
+		// A get_script in progress. Other threads asking for the same path wait on it
+		// instead of loading the script a second time.
+		struct InFlight {
+			Ref<Semaphore> done;
+			uint64_t thread_id = 0;
+			int waiters = 0;
+			Error error = OK;
+		};
+
+		// Scripts are keyed by path and compiled entries by cache key; both pick a
+		// shard by hash so unrelated loads don't contend on one lock.
+		struct Shard {
+			Ref<Mutex> mutex;
+			HashMap<String, Ref<LuauScript>> scripts;
+			HashMap<String, InFlight *> in_flight;
+			HashMap<String, CompiledEntry> compiled;
+			HashMap<String, uint64_t> last_used; // use_clock value of each script's last get_script
+		};
+
+		// Which thread each waiting thread waits on, to catch loads that wait on each other
+		Ref<Mutex> wait_mutex;
+		HashMap<uint64_t, uint64_t> waiting_on;
+
+		// False (and nothing recorded) if waiting on p_owner_id would close a cycle.
+		bool begin_wait(uint64_t p_thread_id, uint64_t p_owner_id);
+		void end_wait(uint64_t p_thread_id);
+
+		static constexpr int SHARD_COUNT = 16;
+		Shard shards[SHARD_COUNT];
+
+		Shard &get_shard(const String &p_key) { return shards[p_key.hash() % SHARD_COUNT]; }
+
+		struct Stats {
+			SafeNumeric<uint64_t> script_hits;
+			SafeNumeric<uint64_t> script_misses;
+			SafeNumeric<uint64_t> bytecode_hits;
+			SafeNumeric<uint64_t> bytecode_misses;
+			SafeNumeric<uint64_t> compiles;
+			SafeNumeric<uint64_t> compile_usec;
+			SafeNumeric<uint64_t> evictions;
+		};
+		Stats stats;
+		SafeNumeric<uint64_t> use_clock;
+
+		// Eviction limits; 0 means unlimited
+		int max_scripts = 0;
+		uint64_t max_memory = 0;
+
+		static uint64_t get_script_memory(const LuauScript *p_script);
+		static bool is_evictable(const Ref<LuauScript> &p_script);
+
+		// Script dependency graph by path, kept in both directions
+		Ref<Mutex> graph_mutex;
+		HashMap<String, PackedStringArray> dependencies;
+		HashMap<String, HashSet<String>> dependents;
+
+		void sort_dependencies_first(const String &p_path, const HashSet<String> &p_affected, HashSet<String> &r_visited, PackedStringArray &r_order) const;
+
+		// Which .luauc file each path last used this session, so an edit removes the
+		// stale one. Identical sources share a key; a file goes once no path uses it.
+		Ref<Mutex> disk_mutex;
+		HashMap<String, String> disk_keys;
+		HashMap<String, int> disk_key_users;
+		int max_disk_files = 0;
+
+		void track_disk_key(const String &p_path, const String &p_key);
+		// Removes the least recently written files beyond luau/cache/max_disk_files.
+		void prune_disk_cache();
+
+		Ref<Mutex> bundle_mutex;
+		LuauBundle bundle;
+		bool open_bundle();
+
+		// One script of a compile_batch. Workers only write to their own job.
+		struct BatchJob {
+			String key;
+			LuauScript::CompiledScript result;
+			Error error = OK;
+			bool cached = false;
+		};
+		friend class LuauCompileBatch;
+		static void compile_batch_job(BatchJob &r_job);
+		// True if the path is cached and done loading up to p_stage.
+		bool is_loaded(const String &p_path, LuauScript::LoadStage p_stage);
 
 		static LuauCache *singleton;
 
+		static String get_cache_dir();
+		static Dictionary serialize_definition(const GDClassDefinition &p_def);
+		static void deserialize_definition(const Dictionary &p_data, GDClassDefinition &r_def);
+
+		static bool entry_from_data(const Dictionary &p_data, CompiledEntry &r_entry);
+		static Dictionary entry_to_data(const CompiledEntry &p_entry);
+
+		// Looks in memory, then on disk. False on a miss.
+		bool find_entry(const String &p_key, CompiledEntry &r_entry);
+		bool has_entry(const String &p_key);
+		void apply_entry(const CompiledEntry &p_entry, LuauScript *p_script);
+		void store_entry(const String &p_key, const LuauScript::CompiledScript &p_script);
+		bool restore_bundled(const String &p_path, LuauScript *p_script);
+
 	public:
 		static LuauCache *get_singleton() { return singleton; }
 
+		// Bump when the serialized layout changes.
+		static constexpr int CACHE_FORMAT_VERSION = 3;
+
+		// Hash of the source, compile profile, lean flag, bytecode version and the Luau
+		// and extension versions. The one-argument form uses the project's settings.
+		static String get_cache_key(const String &p_source);
+		static String get_cache_key(const String &p_source, const String &p_profile, bool p_lean);
+
+		// Fills bytecode, definition and constants from memory or disk. Returns false on a miss.
+		bool restore(const String &p_key, LuauScript *p_script);
+		void store(const String &p_key, const LuauScript *p_script);
+		// The serialized entry for p_key, as stored in cache files and bundles. Empty on a miss.
+		Dictionary get_compiled_data(const String &p_key);
+
+		// Whether p_path is provided by the exported script bundle.
+		bool has_bundled(const String &p_path);
+
+		// Reads, compiles and analyses p_paths on the WorkerThreadPool, then stores the
+		// results on the calling (main) thread. With p_publish, paths are also loaded
+		// through get_script, which then only has to restore from the cache; scripts
+		// already loaded to p_stage are left alone and bundled ones aren't compiled.
+		Error compile_batch(const PackedStringArray &p_paths, bool p_publish = true, LuauScript::LoadStage p_stage = LuauScript::LOAD_FULL, const String &p_profile = String());
+
+		// Compiles and loads p_paths ahead of use, e.g. before a level transition.
+		Error preload(const PackedStringArray &p_paths);
+		// As preload, for a text file listing one res:// path per line ('#' starts a comment).
+		Error preload_manifest(const String &p_manifest);
+
+		// Drops least recently used scripts that nothing else references until the
+		// cache is back within luau/cache/max_scripts and luau/cache/max_memory_kb.
+		void trim();
+		void set_limits(int p_max_scripts, uint64_t p_max_memory) { max_scripts = p_max_scripts; max_memory = p_max_memory; }
+
+		void record_compile(uint64_t p_usec);
+		Dictionary get_stats() const;
+
+		Array get_scripts() const;
+
+		// Records the edges from a freshly analysed script, replacing its old ones.
+		void update_dependencies(const String &p_path, const PackedStringArray &p_dependencies);
+		PackedStringArray get_dependencies(const String &p_path) const;
+		// p_changed plus every script depending on them, each after its own dependencies.
+		PackedStringArray get_reload_order(const PackedStringArray &p_changed) const;
+
 		Ref<LuauScript> get_script(const String &p_path, Error &r_error, bool p_ignore_cache = false, LuauScript::LoadStage p_stage = LuauScript::LOAD_FULL);
 
+	private:
+		Error load_script(const Ref<LuauScript> &p_script, const String &p_path, bool p_reload, LuauScript::LoadStage p_stage);
+
+	public:
+
 		LuauCache();
 		~LuauCache();
 	};
+
+	// The jobs of one compile_batch. The pool callable is bound to it, so batches
+	// started from different threads don't share any state.
+	class LuauCompileBatch : public RefCounted {
+		GDCLASS(LuauCompileBatch, RefCounted);
+
+	protected:
+		static void _bind_methods() {}
+
+	public:
+		LocalVector<LuauCache::BatchJob> jobs;
+
+		void run_job(uint32_t p_index) { LuauCache::compile_batch_job(jobs[p_index]); }
+	};
 };
 
 #endif
\ No newline at end of file
@@ -7,6 +7,7 @@ namespace luau {
     static constexpr char const* LUAUSCRIPT_TYPE = "LuauScript";
     static constexpr char const* LUAUSCRIPT_EXTENSION = "luau";
     static constexpr char const* THEME_SETTING_PREFIX = "text_editor/theme/highlighting/luauscript/";
+    static constexpr char const* PROJECT_SETTING_PREFIX = "luau/";
 } // namespace luau
 } // namespace godot
 
@@ -1,14 +1,18 @@
 #include "luau_engine.h"
 #include "luau_script.h"
+#include "luau_cache.h"
 
 #include <lua.h>
 #include <lualib.h>
+#include <algorithm>
+#include <Luau/CodeGen.h>
 #include <godot_cpp/core/memory.hpp>
 #include <godot_cpp/core/math.hpp>
 #include <godot_cpp/variant/utility_functions.hpp>
 #include <godot_cpp/variant/variant.hpp>
 #include "nobind.h"
 
+#include "luau_constants.h"
 #include "lamda_wrapper.h"
 #include "luau_bridge.h"
 #include "variant/builtin_types.h"
@@ -17,17 +21,6 @@ using namespace godot;
 
 LuauEngine *LuauEngine::singleton = nullptr;
 
-static void *luauGD_alloc(void *, void *ptr, size_t, size_t nsize) {
-	if (nsize == 0) {
-		if (ptr)
-			memfree(ptr);
-
-		return nullptr;
-	}
-
-	return memrealloc(ptr, nsize);
-}
-
 void luaGD_close(lua_State *L) {
 	L = lua_mainthread(L);
 
@@ -666,6 +659,16 @@ void LuauEngine::register_godot_functions(lua_State *L) {
             return 1;
         }
 
+        // Bridged builtins answer from the userdata tag without converting
+        int tag = lua_type(L, 1) == LUA_TUSERDATA ? lua_userdatatag(L, 1) : 0;
+        if (tag != Variant::OBJECT && tag != LuauBridge::UDTAG_ON_READY) {
+            const char *name = LuauBridge::get_tag_name(tag);
+            if (name) {
+                lua_pushstring(L, name);
+                return 1;
+            }
+        }
+
         Variant v = LuauBridge::get_variant(L, 1);
         if (v.get_type() == Variant::OBJECT) {
             Object* obj = v.get_validated_object();
@@ -747,6 +750,8 @@ void LuauEngine::register_godot_functions(lua_State *L) {
 void LuauEngine::register_godot_globals(lua_State *L) {
     register_godot_enums(L);
     register_godot_functions(L);
+    register_task_library(L);
+    register_luau_library(L);
 
     {
         lua_newtable(L);
@@ -754,6 +759,8 @@ void LuauEngine::register_godot_globals(lua_State *L) {
     }
     //MARK: Register Variant types
     {   
+        LuauBridge::register_method_names(L);
+
         StringBridge::register_variant(L);
 
         Vector2Bridge::register_variant(L);
@@ -834,6 +841,10 @@ void LuauEngine::register_godot_globals(lua_State *L) {
         PackedVector3ArrayBridge::register_variant_class(L);
         PackedVector4ArrayBridge::register_variant_class(L);
         PackedColorArrayBridge::register_variant_class(L);
+
+        if (LuauBridge::is_native_vectors()) {
+            Vector3Bridge::register_native_vector(L);
+        }
     }
 
     //Custom functionalities;
@@ -956,26 +967,687 @@ void LuauEngine::register_godot_globals(lua_State *L) {
     lua_settable(L, -3);
 
     LuauBridge::protect_metatable(L, -1);
+
+    // Converts to the Variant the deferred call stored once it has run
+    LuauBridge::register_tag(L, LuauBridge::UDTAG_ON_READY, "OnReadyWrapper", [](lua_State *L, int p_index) -> Variant {
+        void** proxy = (void**)lua_touserdata(L, p_index);
+
+        if (proxy == nullptr || *proxy == nullptr) {
+            luaL_error(L, "Proxy is null or uninitialized");
+            return Variant();
+        }
+
+        return *(Variant*)*proxy;
+    }, nullptr);
+}
+
+Variant LuauEngine::get_project_setting(const String &p_key, const Variant &p_default) {
+    ProjectSettings *settings = nobind::ProjectSettings::get_singleton();
+    String key = String(luau::PROJECT_SETTING_PREFIX) + p_key;
+
+    if (!settings->has_setting(key)) {
+        settings->set_setting(key, p_default);
+    }
+    settings->set_initial_value(key, p_default);
+
+    return settings->get_setting(key, p_default);
+}
+
+//MARK: Native codegen
+void LuauEngine::compile_native(VMType p_type, lua_State *L, int p_idx, const String &p_chunkname) const {
+    if (!codegen_enabled[p_type]) {
+        return;
+    }
+
+    // Without the project-wide switch only `--!native` modules and `@native` functions are compiled.
+    unsigned int flags = codegen_all_scripts ? 0 : Luau::CodeGen::CodeGen_OnlyNativeModules;
+    Luau::CodeGen::CompilationResult result = Luau::CodeGen::compile(L, p_idx, flags);
+
+    switch (result.result) {
+        case Luau::CodeGen::CodeGenCompilationResult::Success:
+        case Luau::CodeGen::CodeGenCompilationResult::NothingToCompile:
+        case Luau::CodeGen::CodeGenCompilationResult::NotNativeModule:
+            break;
+        default:
+            // Functions that failed to compile keep running in the interpreter.
+            print_verbose(vformat("Luau codegen skipped %s (result %d), using interpreter", p_chunkname, (int)result.result));
+            break;
+    }
+}
+
+//MARK: Thread pool
+LuauEngine::PooledThread LuauEngine::acquire_thread(VMType p_type) {
+    LocalVector<PooledThread> &pool = thread_pool[p_type];
+
+    if (!pool.is_empty()) {
+        PooledThread thread = pool[pool.size() - 1];
+        pool.remove_at(pool.size() - 1);
+
+        stats[p_type].threads_reused++;
+        return thread;
+    }
+
+    lua_State *L = vms[p_type];
+
+    PooledThread thread;
+    thread.L = lua_newthread(L);
+    thread.ref = lua_ref(L, -1);
+    lua_pop(L, 1);
+
+    stats[p_type].threads_created++;
+    return thread;
+}
+
+void LuauEngine::release_thread(VMType p_type, const PooledThread &p_thread) {
+    if (!p_thread.L) {
+        return;
+    }
+
+    LocalVector<PooledThread> &pool = thread_pool[p_type];
+
+    if (pool.size() >= thread_pool_size) {
+        lua_unref(vms[p_type], p_thread.ref);
+        return;
+    }
+
+    lua_resetthread(p_thread.L);
+    pool.push_back(p_thread);
+}
+
+//MARK: Watchdog
+void LuauEngine::interrupt(lua_State *L, int p_gc) {
+    if (p_gc >= 0 || !singleton) {
+        return; // GC interrupts aren't script time
+    }
+
+    VMType type = get_vm_type(L);
+    if (type == VM_MAX) {
+        return;
+    }
+
+    CallClock &clock = singleton->call_clocks[type];
+    if (clock.depth == 0) {
+        return;
+    }
+
+    double elapsed = lua_clock() - clock.start;
+    if (singleton->call_budget > 0.0 && elapsed > singleton->call_budget) {
+        singleton->stats[type].budget_violations++;
+        luaL_error(L, "script exceeded the per-call CPU budget of %d ms", int(singleton->call_budget * 1000.0));
+    }
+
+    if (singleton->frame_budget > 0.0 && clock.frame_used + elapsed > singleton->frame_budget) {
+        singleton->stats[type].budget_violations++;
+        luaL_error(L, "scripts exceeded the per-frame CPU budget of %d ms", int(singleton->frame_budget * 1000.0));
+    }
+}
+
+LuauEngine::VMType LuauEngine::get_vm_type(lua_State *L) {
+    lua_State *main = lua_mainthread(L);
+    for (int i = 0; i < VM_MAX; i++) {
+        if (singleton->vms[i] == main) {
+            return VMType(i);
+        }
+    }
+    return VM_MAX;
+}
+
+void LuauEngine::begin_call(VMType p_type) {
+    allocators[p_type].enter_protected();
+
+    CallClock &clock = call_clocks[p_type];
+    if (clock.depth++ == 0) {
+        clock.start = lua_clock();
+    }
+}
+
+void LuauEngine::end_call(VMType p_type) {
+    CallClock &clock = call_clocks[p_type];
+    if (--clock.depth == 0) {
+        clock.frame_used += lua_clock() - clock.start;
+    }
+
+    allocators[p_type].exit_protected();
+}
+
+void LuauEngine::begin_frame() {
+    for (CallClock &clock : call_clocks) {
+        clock.frame_used = 0.0;
+    }
+}
+
+//MARK: Task scheduler
+// Instance code runs with the instance's self table as its environment, which carries the owner.
+static uint64_t get_task_owner(lua_State *L, int p_idx) {
+    if (lua_isfunction(L, p_idx)) {
+        lua_pushvalue(L, p_idx);
+    } else {
+        // A coroutine belongs to whoever hands it in, i.e. the calling function
+        lua_Debug ar;
+        if (!lua_getinfo(L, 1, "f", &ar)) {
+            return 0;
+        }
+    }
+
+    lua_getfenv(L, -1);
+    uint64_t owner = 0;
+    if (lua_istable(L, -1)) {
+        lua_rawgetfield(L, -1, "__godot_owner");
+        Object *obj = (Object *)lua_touserdata(L, -1);
+        if (obj) {
+            owner = obj->get_instance_id();
+        }
+        lua_pop(L, 1);
+    }
+    lua_pop(L, 2); // Env, function
+
+    return owner;
+}
+
+lua_State *LuauEngine::create_task(VMType p_type, lua_State *L, int p_idx) {
+    Task task;
+    task.id = ++task_counter;
+    task.owner = get_task_owner(L, p_idx);
+
+    if (lua_isthread(L, p_idx)) {
+        // Scripts may keep resuming their own coroutines, so those are never recycled.
+        task.thread.L = lua_tothread(L, p_idx);
+        lua_pushvalue(L, p_idx);
+        task.thread.ref = lua_ref(L, -1);
+        lua_pop(L, 1);
+        task.recycle = false;
+    } else {
+        luaL_checktype(L, p_idx, LUA_TFUNCTION);
+        task.thread = acquire_thread(p_type);
+        lua_pushvalue(L, p_idx);
+        lua_xmove(L, task.thread.L, 1);
+    }
+
+    tasks[p_type][task.thread.L] = task;
+    if (task.owner) {
+        owned_tasks[p_type][task.owner].insert(task.thread.L);
+    }
+    stats[p_type].tasks_spawned++;
+
+    return task.thread.L;
+}
+
+void LuauEngine::schedule_task(VMType p_type, lua_State *T, double p_wake_time, int p_nargs, double p_wait_start) {
+    ScheduledTask entry;
+    entry.wake_time = p_wake_time;
+    entry.order = ++task_counter;
+    entry.L = T;
+    entry.id = tasks[p_type][T].id;
+    entry.wait_start = p_wait_start;
+    entry.nargs = p_nargs;
+
+    LocalVector<ScheduledTask> &heap = task_heap[p_type];
+    heap.push_back(entry);
+    std::push_heap(heap.ptr(), heap.ptr() + heap.size(), ScheduledTask());
+}
+
+void LuauEngine::resume_task(VMType p_type, lua_State *T, int p_nargs) {
+    stats[p_type].tasks_resumed++;
+
+    begin_call(p_type);
+    int status = lua_resume(T, nullptr, p_nargs);
+    end_call(p_type);
+
+    if (status == LUA_YIELD) {
+        // Either task.wait rescheduled it, or the script will resume it itself.
+        lua_pop(T, lua_gettop(T));
+        return;
+    }
+
+    if (status != LUA_OK) {
+        const char *error_msg = lua_tostring(T, -1);
+        UtilityFunctions::printerr(vformat("Luau task error: %s", error_msg ? error_msg : "unknown error"));
+    }
+
+    finish_task(p_type, T);
+}
+
+void LuauEngine::finish_task(VMType p_type, lua_State *T) {
+    Task *task = tasks[p_type].getptr(T);
+    if (!task) {
+        return;
+    }
+
+    Task finished = *task;
+    tasks[p_type].erase(T);
+
+    if (finished.owner) {
+        HashSet<lua_State *> *owned = owned_tasks[p_type].getptr(finished.owner);
+        if (owned) {
+            owned->erase(T);
+            if (owned->is_empty()) {
+                owned_tasks[p_type].erase(finished.owner);
+            }
+        }
+    }
+
+    if (finished.recycle) {
+        release_thread(p_type, finished.thread);
+    } else {
+        lua_unref(vms[p_type], finished.thread.ref);
+    }
+}
+
+bool LuauEngine::cancel_task(VMType p_type, lua_State *T) {
+    if (!tasks[p_type].has(T)) {
+        return false;
+    }
+
+    // Resetting a thread that is mid-resume (it resumed the caller) would pull the stack out from under it
+    int status = lua_costatus(vms[p_type], T);
+    ERR_FAIL_COND_V_MSG(status == LUA_CORUN || status == LUA_CONOR, false, "Cannot cancel a task that is running");
+
+    // Heap entries are left behind; their id no longer matches anything.
+    finish_task(p_type, T);
+    return true;
+}
+
+void LuauEngine::cancel_owned_tasks(VMType p_type, uint64_t p_owner) {
+    HashSet<lua_State *> *owned = owned_tasks[p_type].getptr(p_owner);
+    if (!owned) {
+        return;
+    }
+
+    LocalVector<lua_State *> pending;
+    for (lua_State *T : *owned) {
+        pending.push_back(T);
+    }
+
+    for (lua_State *T : pending) {
+        // A task freeing its own owner is still on the stack; it finishes on its own
+        int status = lua_costatus(vms[p_type], T);
+        if (status != LUA_CORUN && status != LUA_CONOR) {
+            finish_task(p_type, T);
+        }
+    }
+}
+
+void LuauEngine::finish_if_done(VMType p_type, lua_State *T) {
+    if (!tasks[p_type].has(T)) {
+        return;
+    }
+
+    int status = lua_costatus(vms[p_type], T);
+    if (status == LUA_COFIN || status == LUA_COERR) {
+        finish_task(p_type, T);
+    }
+}
+
+void LuauEngine::resume_tasks() {
+    double now = lua_clock();
+
+    for (int i = 0; i < VM_MAX; i++) {
+        VMType type = VMType(i);
+        LocalVector<ScheduledTask> &heap = task_heap[i];
+
+        // Tasks scheduled while resuming (task.defer, task.wait(0)) run next frame.
+        uint64_t last_order = task_counter;
+
+        while (!heap.is_empty()) {
+            ScheduledTask entry = heap[0];
+            if (entry.wake_time > now || entry.order > last_order) {
+                break;
+            }
+
+            std::pop_heap(heap.ptr(), heap.ptr() + heap.size(), ScheduledTask());
+            heap.remove_at(heap.size() - 1);
+
+            const Task *task = tasks[i].getptr(entry.L);
+            if (!task || task->id != entry.id) {
+                continue; // Cancelled
+            }
+
+            int nargs = entry.nargs;
+            if (entry.wait_start >= 0.0) {
+                lua_pushnumber(entry.L, now - entry.wait_start);
+                nargs = 1;
+            }
+
+            resume_task(type, entry.L, nargs);
+        }
+    }
+}
+
+void LuauEngine::register_task_library(lua_State *L) {
+    lua_newtable(L);
+
+    // task.spawn(fn | thread, ...) runs it now, until it finishes or waits
+    lua_pushcfunction(L, [](lua_State *L) -> int {
+        VMType type = get_vm_type(L);
+        int nargs = lua_gettop(L) - 1;
+
+        lua_State *T = singleton->create_task(type, L, 1);
+        lua_pushthread(T);
+        lua_xmove(T, L, 1); // Return value, kept below the args
+
+        lua_insert(L, 2);
+        lua_xmove(L, T, nargs);
+        singleton->resume_task(type, T, nargs);
+
+        return 1;
+    }, "task.spawn");
+    lua_setfield(L, -2, "spawn");
+
+    // task.defer(fn | thread, ...) runs it on the next frame
+    lua_pushcfunction(L, [](lua_State *L) -> int {
+        VMType type = get_vm_type(L);
+        int nargs = lua_gettop(L) - 1;
+
+        lua_State *T = singleton->create_task(type, L, 1);
+        lua_xmove(L, T, nargs);
+        singleton->schedule_task(type, T, 0.0, nargs);
+
+        lua_pushthread(T);
+        lua_xmove(T, L, 1);
+        return 1;
+    }, "task.defer");
+    lua_setfield(L, -2, "defer");
+
+    // task.delay(seconds, fn | thread, ...) runs it once the delay has passed
+    lua_pushcfunction(L, [](lua_State *L) -> int {
+        VMType type = get_vm_type(L);
+        double delay = luaL_checknumber(L, 1);
+        int nargs = lua_gettop(L) - 2;
+
+        lua_State *T = singleton->create_task(type, L, 2);
+        lua_xmove(L, T, nargs);
+        singleton->schedule_task(type, T, lua_clock() + delay, nargs);
+
+        lua_pushthread(T);
+        lua_xmove(T, L, 1);
+        return 1;
+    }, "task.delay");
+    lua_setfield(L, -2, "delay");
+
+    // task.wait(seconds?) suspends the running task and returns the time actually waited
+    lua_pushcfunction(L, [](lua_State *L) -> int {
+        VMType type = get_vm_type(L);
+        if (!singleton->tasks[type].has(L)) {
+            luaL_error(L, "task.wait can only be called from a task; start one with task.spawn");
+        }
+
+        double now = lua_clock();
+        singleton->schedule_task(type, L, now + luaL_optnumber(L, 1, 0.0), 0, now);
+        return lua_yield(L, 0);
+    }, "task.wait");
+    lua_setfield(L, -2, "wait");
+
+    // task.cancel(thread) stops a task before it runs again
+    lua_pushcfunction(L, [](lua_State *L) -> int {
+        luaL_checktype(L, 1, LUA_TTHREAD);
+        lua_State *T = lua_tothread(L, 1);
+        int status = lua_costatus(L, T);
+        if (status == LUA_CORUN || status == LUA_CONOR) {
+            luaL_error(L, "task.cancel cannot cancel a running task");
+        }
+
+        lua_pushboolean(L, singleton->cancel_task(get_vm_type(L), T));
+        return 1;
+    }, "task.cancel");
+    lua_setfield(L, -2, "cancel");
+
+    lua_setreadonly(L, -1, true);
+    lua_setglobal(L, "task");
+
+    // Tasks a script resumes (or closes) to completion itself never pass through resume_task,
+    // so release them where that happens rather than sweeping every task each frame
+    lua_getglobal(L, "coroutine");
+    const char *finishers[] = { "resume", "close" };
+    for (const char *name : finishers) {
+        lua_getfield(L, -1, name);
+        lua_pushcclosure(L, [](lua_State *L) -> int {
+            lua_State *T = lua_tothread(L, 1);
+            int nargs = lua_gettop(L);
+
+            lua_pushvalue(L, lua_upvalueindex(1));
+            lua_insert(L, 1);
+            lua_call(L, nargs, LUA_MULTRET);
+
+            if (T) {
+                singleton->finish_if_done(get_vm_type(L), T);
+            }
+            return lua_gettop(L);
+        }, name, 1);
+        lua_setfield(L, -2, name);
+    }
+    lua_pop(L, 1);
+}
+
+void LuauEngine::register_luau_library(lua_State *L) {
+    lua_newtable(L);
+
+    // luau.stats() returns the counters behind the Luau/ debugger monitors
+    lua_pushcfunction(L, [](lua_State *L) -> int {
+        LuauLanguage *language = LuauLanguage::get_singleton();
+        LuauBridge::push_variant(L, language ? language->get_stats() : Dictionary());
+        return 1;
+    }, "luau.stats");
+    lua_setfield(L, -2, "stats");
+
+    // luau.preload(paths | manifest_path) compiles and loads scripts ahead of use
+    lua_pushcfunction(L, [](lua_State *L) -> int {
+        LuauCache *cache = LuauCache::get_singleton();
+        if (!cache) {
+            luaL_error(L, "luau.preload: script cache is not available");
+        }
+
+        Variant arg = LuauBridge::get_variant(L, 1);
+        Error err = arg.get_type() == Variant::STRING
+                ? cache->preload_manifest(arg)
+                : cache->preload(PackedStringArray(arg));
+
+        lua_pushboolean(L, err == OK);
+        return 1;
+    }, "luau.preload");
+    lua_setfield(L, -2, "preload");
+
+    lua_setreadonly(L, -1, true);
+    lua_setglobal(L, "luau");
+}
+
+//MARK: GC scheduling
+void LuauEngine::configure_gc(lua_State *L) {
+    lua_gc(L, LUA_GCSETGOAL, gc_goal_percent);
+    lua_gc(L, LUA_GCSETSTEPMUL, get_project_setting("gc/step_multiplier", 200));
+    lua_gc(L, LUA_GCSETSTEPSIZE, gc_step_kb);
+}
+
+void LuauEngine::queue_unref(VMType p_type, int p_ref) {
+    if (p_ref == LUA_NOREF || p_ref == LUA_REFNIL) {
+        return;
+    }
+
+    MutexLock lock(*unref_mutex.ptr());
+    pending_unrefs[p_type].push_back(p_ref);
+    stats[p_type].unrefs_deferred++;
+}
+
+bool LuauEngine::flush_unrefs(VMType p_type, uint64_t p_deadline) {
+    Time *time = nobind::Time::get_singleton();
+    MutexLock lock(*unref_mutex.ptr());
+
+    LocalVector<int> &pending = pending_unrefs[p_type];
+    while (!pending.is_empty()) {
+        // Check the clock every few dozen refs; a single unref is cheap.
+        uint32_t batch = MIN(pending.size(), 64u);
+        for (uint32_t i = 0; i < batch; i++) {
+            lua_unref(vms[p_type], pending[pending.size() - 1]);
+            pending.remove_at(pending.size() - 1);
+        }
+
+        if (time->get_ticks_usec() >= p_deadline) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+void LuauEngine::step_gc(uint64_t p_headroom_usec) {
+    Time *time = nobind::Time::get_singleton();
+    uint64_t start = time->get_ticks_usec();
+
+    uint32_t pending = 0;
+    {
+        MutexLock lock(*unref_mutex.ptr());
+        for (const LocalVector<int> &refs : pending_unrefs) {
+            pending += refs.size();
+        }
+    }
+
+    // A burst of destroyed instances means a scene transition; time left before the frame deadline can go to the GC.
+    uint64_t budget = gc_frame_budget_usec;
+    if (pending >= gc_transition_unrefs) {
+        budget = gc_transition_budget_usec;
+    } else if (p_headroom_usec >= gc_idle_headroom_usec) {
+        budget = gc_idle_budget_usec;
+    }
+
+    uint64_t deadline = start + budget;
+
+    // User code churns the most, so it gets first claim on the budget.
+    const VMType order[] = { VM_USER, VM_CORE, VM_SCRIPT_LOAD };
+    for (VMType type : order) {
+        lua_State *L = vms[type];
+        uint64_t vm_start = time->get_ticks_usec();
+
+        if (!flush_unrefs(type, deadline)) {
+            break;
+        }
+
+        // Start cycles halfway to the allocation goal, so frame steps finish them
+        // before debt forces a collection in the middle of a tick.
+        uint64_t live = allocators[type].get_stats().live_bytes;
+        if (gc_in_cycle[type] || live >= gc_trigger_bytes[type]) {
+            gc_in_cycle[type] = true;
+
+            while (time->get_ticks_usec() < deadline) {
+                stats[type].gc_steps++;
+                if (lua_gc(L, LUA_GCSTEP, gc_step_kb)) {
+                    stats[type].gc_cycles++;
+                    gc_in_cycle[type] = false;
+
+                    live = allocators[type].get_stats().live_bytes;
+                    gc_trigger_bytes[type] = live + live * (gc_goal_percent - 100) / 200;
+                    break;
+                }
+            }
+        }
+
+        stats[type].gc_usec += time->get_ticks_usec() - vm_start;
+
+        if (time->get_ticks_usec() >= deadline) {
+            break;
+        }
+    }
+}
+
+Dictionary LuauEngine::get_stats() const {
+    VMStats total;
+    LuauAllocator::Stats heap;
+    for (int i = 0; i < VM_MAX; i++) {
+        const LuauAllocator::Stats &vm_heap = allocators[i].get_stats();
+        heap.live_bytes += vm_heap.live_bytes;
+        heap.peak_bytes += vm_heap.peak_bytes;
+        heap.allocations += vm_heap.allocations;
+        heap.frees += vm_heap.frees;
+
+        total.threads_created += stats[i].threads_created;
+        total.threads_reused += stats[i].threads_reused;
+        total.notifications_skipped += stats[i].notifications_skipped;
+        total.gc_steps += stats[i].gc_steps;
+        total.gc_cycles += stats[i].gc_cycles;
+        total.gc_usec += stats[i].gc_usec;
+        total.unrefs_deferred += stats[i].unrefs_deferred;
+        total.budget_violations += stats[i].budget_violations;
+        total.tasks_spawned += stats[i].tasks_spawned;
+        total.tasks_resumed += stats[i].tasks_resumed;
+    }
+
+    Dictionary result;
+    result["threads_created"] = total.threads_created;
+    // Every reuse is one lua_newthread allocation avoided.
+    result["threads_reused"] = total.threads_reused;
+    // Notifications answered without entering the VM.
+    result["notifications_skipped"] = total.notifications_skipped;
+    result["heap_live_bytes"] = heap.live_bytes;
+    // Sum of the per-VM peaks; see get_heap_stats() for a single VM.
+    result["heap_peak_bytes"] = heap.peak_bytes;
+    result["heap_allocations"] = heap.allocations;
+    result["heap_frees"] = heap.frees;
+    result["gc_steps"] = total.gc_steps;
+    result["gc_cycles"] = total.gc_cycles;
+    result["gc_usec"] = total.gc_usec;
+    result["unrefs_deferred"] = total.unrefs_deferred;
+    result["budget_violations"] = total.budget_violations;
+    result["tasks_spawned"] = total.tasks_spawned;
+    result["tasks_resumed"] = total.tasks_resumed;
+
+    return result;
 }
 
 void LuauEngine::init_vm(VMType p_type) {
-    lua_State *L = lua_newstate(luauGD_alloc, nullptr);
+    lua_State *L = lua_newstate(LuauAllocator::lua_alloc, &allocators[p_type]);
+    lua_callbacks(L)->useratom = LuauBridge::user_atom;
+
+    if (codegen_requested && Luau::CodeGen::isSupported()) {
+        Luau::CodeGen::create(L);
+        codegen_enabled[p_type] = true;
+    }
 
     luaL_openlibs(L);
     
     // Register Godot globals before sandboxing
     register_godot_globals(L);
 
+    lua_newtable(L);
+    lua_setfield(L, LUA_REGISTRYINDEX, CLASS_CACHE_KEY);
+
     luaL_sandbox(L);
 
+    configure_gc(L);
+
+    if (call_budget > 0.0 || frame_budget > 0.0) {
+        lua_callbacks(L)->interrupt = interrupt;
+    }
+
     vms[p_type] = L;
 }
 
 LuauEngine::LuauEngine() {
+    codegen_requested = get_project_setting("codegen/enabled", true);
+    codegen_all_scripts = get_project_setting("codegen/compile_all_scripts", false);
+    thread_pool_size = (int)get_project_setting("runtime/thread_pool_size", 64);
+    LuauBridge::set_native_vectors(get_project_setting("runtime/native_vectors", false));
+
+    gc_goal_percent = MAX((int)get_project_setting("gc/goal_percent", 200), 100);
+    gc_frame_budget_usec = (int64_t)get_project_setting("gc/frame_budget_usec", 500);
+    gc_idle_budget_usec = (int64_t)get_project_setting("gc/idle_budget_usec", 2000);
+    gc_idle_headroom_usec = (int64_t)get_project_setting("gc/idle_headroom_usec", 4000);
+    gc_transition_budget_usec = (int64_t)get_project_setting("gc/transition_budget_usec", 4000);
+    gc_transition_unrefs = (int)get_project_setting("gc/transition_unref_threshold", 256);
+    gc_step_kb = get_project_setting("gc/step_size_kb", 1);
+
+    unref_mutex.instantiate();
+
+    call_budget = (int)get_project_setting("limits/call_budget_msec", 0) / 1000.0;
+    frame_budget = (int)get_project_setting("limits/frame_budget_msec", 0) / 1000.0;
+
 	init_vm(VM_SCRIPT_LOAD);
 	init_vm(VM_CORE);
 	init_vm(VM_USER);
 
+    // Ceilings apply after the VMs are set up, so the base libraries always fit.
+    allocators[VM_CORE].set_limit(uint64_t((int)get_project_setting("limits/core_memory_mb", 0)) << 20);
+    allocators[VM_USER].set_limit(uint64_t((int)get_project_setting("limits/user_memory_mb", 0)) << 20);
+
+    print_verbose(vformat("Luau native codegen: %s", codegen_enabled[VM_USER] ? "enabled" : "unavailable, using interpreter"));
+
     if (!singleton) {
         singleton = this;
     }
@@ -986,6 +1658,13 @@ LuauEngine::~LuauEngine() {
 		singleton = nullptr;
 	}
 
+    for (int i = 0; i < VM_MAX; i++) {
+        tasks[i].clear();
+        owned_tasks[i].clear();
+        task_heap[i].clear();
+        thread_pool[i].clear();
+    }
+
     for (lua_State *&L : vms) {
 		luaGD_close(L);
 		L = nullptr;
@@ -4,6 +4,15 @@
 #include <lua.h>
 #include <godot_cpp/core/mutex_lock.hpp>
 #include <godot_cpp/core/type_info.hpp>
+#include <godot_cpp/classes/mutex.hpp>
+#include <godot_cpp/classes/ref.hpp>
+#include <godot_cpp/templates/hash_map.hpp>
+#include <godot_cpp/templates/hash_set.hpp>
+#include <godot_cpp/templates/local_vector.hpp>
+#include <godot_cpp/variant/dictionary.hpp>
+#include <godot_cpp/variant/variant.hpp>
+
+#include "luau_allocator.h"
 
 namespace godot {
 
@@ -19,10 +28,115 @@ public:
         VM_MAX
     };
 
+    // A reusable thread for engine-to-script calls, kept alive by a registry ref.
+    struct PooledThread {
+        lua_State *L = nullptr;
+        int ref = LUA_NOREF;
+    };
+
+    // Registry table of ClassDB class tables already resolved by script environments.
+    static constexpr const char *CLASS_CACHE_KEY = "LuauClassCache";
+
+    struct VMStats {
+        uint64_t threads_created = 0;
+        uint64_t threads_reused = 0;
+        uint64_t notifications_skipped = 0;
+        uint64_t gc_steps = 0;
+        uint64_t gc_cycles = 0;
+        uint64_t gc_usec = 0;
+        uint64_t unrefs_deferred = 0;
+        uint64_t budget_violations = 0;
+        uint64_t tasks_spawned = 0;
+        uint64_t tasks_resumed = 0;
+    };
+
 private:
     static LuauEngine *singleton;
     lua_State *vms[VM_MAX];
     void init_vm(VMType p_type);
+
+    // One heap per VM; members are destroyed after ~LuauEngine has closed the VMs.
+    LuauAllocator allocators[VM_MAX];
+
+    // Native code generation
+    bool codegen_requested = true;
+    bool codegen_all_scripts = false;
+    bool codegen_enabled[VM_MAX] = {};
+
+    // Call thread pool
+    uint32_t thread_pool_size = 64;
+    LocalVector<PooledThread> thread_pool[VM_MAX];
+
+    VMStats stats[VM_MAX];
+
+    // Frame-driven GC
+    uint64_t gc_frame_budget_usec = 500;
+    uint64_t gc_idle_budget_usec = 2000;
+    uint64_t gc_transition_budget_usec = 4000;
+    uint64_t gc_idle_headroom_usec = 4000; // Frame time left that counts as idle
+    uint32_t gc_transition_unrefs = 256;
+    int gc_step_kb = 1;
+    int gc_goal_percent = 200;
+    bool gc_in_cycle[VM_MAX] = {};
+    uint64_t gc_trigger_bytes[VM_MAX] = {};
+
+    // Registry refs released by destroyed instances, freed from step_gc().
+    Ref<Mutex> unref_mutex;
+    LocalVector<int> pending_unrefs[VM_MAX];
+
+    // Watchdog: CPU budgets (seconds, 0 disables) checked from the interrupt callback
+    double call_budget = 0.0;
+    double frame_budget = 0.0;
+
+    struct CallClock {
+        int depth = 0;
+        double start = 0.0;
+        double frame_used = 0.0;
+    };
+    CallClock call_clocks[VM_MAX];
+
+    static void interrupt(lua_State *L, int p_gc);
+
+    // Task scheduler. Every live task owns a thread; sleeping ones also have a
+    // heap entry. Entries whose id no longer matches the task are stale (cancelled).
+    struct Task {
+        PooledThread thread;
+        uint64_t id = 0;
+        bool recycle = true; // False for coroutines handed in by scripts
+        uint64_t owner = 0; // ObjectID of the script instance whose code spawned it, 0 for none
+    };
+
+    struct ScheduledTask {
+        double wake_time = 0.0;
+        uint64_t order = 0; // FIFO among equal wake times
+        lua_State *L = nullptr;
+        uint64_t id = 0;
+        double wait_start = -1.0; // >= 0 when resumed from task.wait, which returns the elapsed time
+        int nargs = 0;
+
+        bool operator()(const ScheduledTask &p_a, const ScheduledTask &p_b) const {
+            // std heap functions build a max-heap, so invert to get the earliest on top.
+            return p_a.wake_time != p_b.wake_time ? p_a.wake_time > p_b.wake_time : p_a.order > p_b.order;
+        }
+    };
+
+    HashMap<lua_State *, Task> tasks[VM_MAX];
+    HashMap<uint64_t, HashSet<lua_State *>> owned_tasks[VM_MAX]; // By Task::owner, so a freed instance finds its tasks
+    LocalVector<ScheduledTask> task_heap[VM_MAX];
+    uint64_t task_counter = 0;
+
+    static void register_task_library(lua_State *L);
+    static void register_luau_library(lua_State *L);
+
+    lua_State *create_task(VMType p_type, lua_State *L, int p_idx);
+    void schedule_task(VMType p_type, lua_State *T, double p_wake_time, int p_nargs, double p_wait_start = -1.0);
+    void resume_task(VMType p_type, lua_State *T, int p_nargs);
+    void finish_task(VMType p_type, lua_State *T);
+    bool cancel_task(VMType p_type, lua_State *T);
+    void finish_if_done(VMType p_type, lua_State *T);
+
+    void configure_gc(lua_State *L);
+    bool flush_unrefs(VMType p_type, uint64_t p_deadline);
     
     // Godot type registration functions
     static void register_godot_enums(lua_State *L);
@@ -33,6 +147,42 @@ private:
 
 public:
     static LuauEngine *get_singleton() { return singleton; };
+    // The VM a thread belongs to, VM_MAX for a foreign state.
+    static VMType get_vm_type(lua_State *L);
+
+    // Reads a `luau/` project setting, registering its default on first use.
+    static Variant get_project_setting(const String &p_key, const Variant &p_default);
+
+    bool is_codegen_enabled(VMType p_type) const { return codegen_enabled[p_type]; }
+    void compile_native(VMType p_type, lua_State *L, int p_idx, const String &p_chunkname) const;
+
+    PooledThread acquire_thread(VMType p_type);
+    void release_thread(VMType p_type, const PooledThread &p_thread);
+
+    const VMStats &get_vm_stats(VMType p_type) const { return stats[p_type]; }
+
+    // Safe to call from any thread; the ref is released during the next step_gc().
+    void queue_unref(VMType p_type, int p_ref);
+    // Runs deferred unrefs and incremental GC steps within this frame's budget. p_headroom_usec is
+    // the time left before the frame deadline; enough of it buys the larger idle budget.
+    void step_gc(uint64_t p_headroom_usec);
+
+    // Brackets engine-to-script calls (pcall or resume) so the watchdog can time them
+    // and the heap limit applies. Nested calls count towards the outermost one.
+    void begin_call(VMType p_type);
+    void end_call(VMType p_type);
+    void begin_frame();
+
+    // Resumes every task whose wake time has passed. Called once per process and physics frame.
+    void resume_tasks();
+    uint32_t get_task_count(VMType p_type) const { return tasks[p_type].size(); }
+    // Cancels the tasks spawned by an instance's code, which would otherwise resume against a freed owner.
+    void cancel_owned_tasks(VMType p_type, uint64_t p_owner);
+
+    void count_skipped_notification(VMType p_type) { stats[p_type].notifications_skipped++; }
+    const LuauAllocator::Stats &get_heap_stats(VMType p_type) const { return allocators[p_type].get_stats(); }
+    uint64_t get_heap_limit(VMType p_type) const { return allocators[p_type].get_limit(); }
+    Dictionary get_stats() const;
 
     lua_State *get_vm(VMType p_type) { 
         if (p_type >= 0 && p_type < VM_MAX) {
@@ -0,0 +1,89 @@
+#include "luau_export_plugin.h"
+
+#include <godot_cpp/classes/dir_access.hpp>
+#include <godot_cpp/classes/file_access.hpp>
+#include <godot_cpp/variant/utility_functions.hpp>
+
+#include "luau_bundle.h"
+#include "luau_cache.h"
+#include "luau_constants.h"
+#include "luau_engine.h"
+#include "luau_script.h"
+
+using namespace godot;
+
+String LuauExportPlugin::_get_name() const {
+    return "LuauScript";
+}
+
+void LuauExportPlugin::find_scripts(const String &p_dir, PackedStringArray &r_paths) {
+    PackedStringArray dirs = DirAccess::get_directories_at(p_dir);
+    for (const String &dir : dirs) {
+        // Skips .godot and other hidden folders
+        if (!dir.begins_with(".")) {
+            find_scripts(p_dir.path_join(dir), r_paths);
+        }
+    }
+
+    PackedStringArray files = DirAccess::get_files_at(p_dir);
+    for (const String &file : files) {
+        if (file.get_extension().to_lower() == luau::LUAUSCRIPT_EXTENSION) {
+            r_paths.push_back(p_dir.path_join(file));
+        }
+    }
+}
+
+void LuauExportPlugin::_export_begin(const PackedStringArray &p_features, bool p_is_debug, const String &p_path, uint32_t p_flags) {
+    bundled.clear();
+
+    if (!bool(LuauEngine::get_project_setting("export/bundle_scripts", true))) {
+        return;
+    }
+
+    // Files are only handed to _export_file after the bundle has to exist, so this
+    // bundles every script in the project regardless of the preset's filters.
+    PackedStringArray paths;
+    find_scripts("res://", paths);
+    if (paths.is_empty()) {
+        return;
+    }
+
+    LuauCache *cache = LuauCache::get_singleton();
+    String profile = LuauScript::get_compile_profile(p_is_debug);
+    // compile_batch analyses with the editor's lean setting, so its keys do too
+    bool lean = LuauScript::is_lean_load();
+
+    if (cache->compile_batch(paths, false, LuauScript::LOAD_ANALYSIS, profile) != OK) {
+        WARN_PRINT("Some Luau scripts failed to compile; they are exported as source");
+    }
+
+    PackedStringArray bundle_paths;
+    Vector<PackedByteArray> blobs;
+
+    for (const String &path : paths) {
+        String key = LuauCache::get_cache_key(FileAccess::get_file_as_string(path), profile, lean);
+        Dictionary data = cache->get_compiled_data(key);
+        if (data.is_empty()) {
+            continue;
+        }
+
+        bundle_paths.push_back(path);
+        blobs.push_back(UtilityFunctions::var_to_bytes(data));
+        bundled.insert(path);
+    }
+
+    bool compress = LuauEngine::get_project_setting("export/compress_bundle", true);
+    add_file(LuauBundle::BUNDLE_PATH, LuauBundle::pack(bundle_paths, blobs, compress), false);
+
+    print_verbose(vformat("Luau: bundled %d of %d scripts (%s profile)", bundle_paths.size(), paths.size(), profile));
+}
+
+void LuauExportPlugin::_export_file(const String &p_path, const String &p_type, const PackedStringArray &p_features) {
+    if (bundled.has(p_path) && bool(LuauEngine::get_project_setting("export/strip_sources", true))) {
+        skip();
+    }
+}
+
+void LuauExportPlugin::_export_end() {
+    bundled.clear();
+}
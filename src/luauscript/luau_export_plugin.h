@@ -0,0 +1,30 @@
+#ifndef LUAU_EXPORT_PLUGIN_H
+#define LUAU_EXPORT_PLUGIN_H
+
+#include <godot_cpp/godot.hpp>
+#include <godot_cpp/classes/editor_export_plugin.hpp>
+#include <godot_cpp/templates/hash_set.hpp>
+
+namespace godot {
+    // Compiles every project script into one LuauBundle at export time, so games boot
+    // without opening or compiling individual .luau files.
+    class LuauExportPlugin : public EditorExportPlugin {
+        GDCLASS(LuauExportPlugin, EditorExportPlugin);
+
+    protected:
+        static void _bind_methods() {};
+
+    private:
+        HashSet<String> bundled;
+
+        static void find_scripts(const String &p_dir, PackedStringArray &r_paths);
+
+    public:
+        String _get_name() const override;
+        void _export_begin(const PackedStringArray &p_features, bool p_is_debug, const String &p_path, uint32_t p_flags) override;
+        void _export_file(const String &p_path, const String &p_type, const PackedStringArray &p_features) override;
+        void _export_end() override;
+    };
+}
+
+#endif
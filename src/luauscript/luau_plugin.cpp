@@ -15,4 +15,14 @@ void LuauPlugin::_enter_tree() {
         "Failed to instantiate Luau syntax highlighter.");
 
     script_editor->register_syntax_highlighter(syntax_highlighter);
-}
\ No newline at end of file
+
+    export_plugin.instantiate();
+    add_export_plugin(export_plugin);
+}
+
+void LuauPlugin::_exit_tree() {
+    if (export_plugin.is_valid()) {
+        remove_export_plugin(export_plugin);
+        export_plugin.unref();
+    }
+}
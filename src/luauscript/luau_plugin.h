@@ -4,6 +4,7 @@
 #include <godot_cpp/godot.hpp>
 #include <godot_cpp/classes/editor_plugin.hpp>
 #include "luauscript_syntax_highlighter.h"
+#include "luau_export_plugin.h"
 
 namespace godot {
     class LuauPlugin : public EditorPlugin {
@@ -14,8 +15,10 @@ namespace godot {
 
     public:
         Ref<LuauSyntaxHighlighter> syntax_highlighter;
+        Ref<LuauExportPlugin> export_plugin;
 
         void _enter_tree() override;
+        void _exit_tree() override;
     };
 }
 
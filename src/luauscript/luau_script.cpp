@@ -5,6 +5,10 @@
 #include <godot_cpp/classes/editor_settings.hpp>
 #include <godot_cpp/classes/engine.hpp>
 #include <godot_cpp/classes/resource_loader.hpp>
+#include <godot_cpp/classes/scene_tree.hpp>
+#include <godot_cpp/classes/performance.hpp>
+#include <godot_cpp/classes/display_server.hpp>
+#include <godot_cpp/variant/callable_method_pointer.hpp>
 #include <godot_cpp/variant/string.hpp>
 #include <godot_cpp/variant/typed_array.hpp>
 #include <godot_cpp/variant/dictionary.hpp>
@@ -23,6 +27,9 @@
 #include "variant/builtin_types.h"
 #include "lamda_wrapper.h"
 
+#include <climits>
+
+#include <Luau/BytecodeBuilder.h>
 #include <Luau/Compiler.h>
 #include <Luau/Parser.h>
 #include <Luau/ParseResult.h>
@@ -642,14 +649,12 @@ void LuauScriptInstance::call(
         return;
     }
 
-	if (!script->definition.is_tool && Engine::get_singleton()->is_editor_hint()) {
+	if (skip_calls) {
 		r_error->error = GDEXTENSION_CALL_OK;
 		return;
 	}
-    
-    const LuauScript *s = script.ptr();
-    
-	if (p_method == StringName("_ready") && !is_ready) {
+
+	if (!is_ready && p_method == LuauLanguage::get_singleton()->ready_name) {
 		is_ready = true;
 		for (int a=0; a < on_ready_funcs.size(); a++) {
 			godot::Callable c = on_ready_funcs[a];
@@ -661,60 +666,49 @@ void LuauScriptInstance::call(
 		on_ready_funcs.clear();
 	}
 
-    // Look for the method in the script hierarchy
-    while (s) {
-        if (s->definition.methods.has(p_method)) {
-            const GDMethod &method = s->definition.methods[p_method];
-            
-            int args_allowed = method.arguments.size();
-            int args_default = method.default_arguments.size();
-            int args_required = args_allowed - args_default;
-            
-            if (p_argument_count < args_required) {
-                r_error->error = GDEXTENSION_CALL_ERROR_TOO_FEW_ARGUMENTS;
-                r_error->argument = args_required;
-                return;
-            }
-            
-            if (p_argument_count > args_allowed && !method.flags.has_flag(METHOD_FLAG_VARARG)) {
-                r_error->error = GDEXTENSION_CALL_ERROR_TOO_MANY_ARGUMENTS;
-                r_error->argument = args_allowed;
-                return;
-            }
-            
-            lua_State *ET = lua_newthread(T);
-            
-            for (int i = 0; i < p_argument_count; i++) {
-                const Variant &arg = *p_args[i];
-                LuauBridge::push_variant(ET, arg);
-            }
-            
-            // Add default arguments
-            for (int i = p_argument_count; i < args_allowed; i++) {
-                int default_idx = i - (args_allowed - args_default);
-                if (default_idx >= 0 && default_idx < args_default) {
-                    LuauBridge::push_variant(ET, method.default_arguments[default_idx]);
-                }
-            }
-            
-            r_error->error = GDEXTENSION_CALL_OK;
-            int status = call_internal(p_method, ET, args_allowed, 1);
-            
-            if (status == LUA_OK) {
-                *r_return = LuauBridge::get_variant(ET, -1);
-            } else {
-                *r_return = Variant();
-                r_error->error = GDEXTENSION_CALL_ERROR_METHOD_NOT_CONST;
-            }
-            
-            lua_pop(T, 1); // Remove thread
-            return;
-        }
-        
-        s = s->base.ptr();
+    script->update_dispatch();
+    const LuauScript::MethodDispatch *method = script->get_dispatch(p_method);
+    if (!method) {
+        r_error->error = GDEXTENSION_CALL_ERROR_INVALID_METHOD;
+        return;
     }
-    
-    r_error->error = GDEXTENSION_CALL_ERROR_INVALID_METHOD;
+
+    if (p_argument_count < method->args_required) {
+        r_error->error = GDEXTENSION_CALL_ERROR_TOO_FEW_ARGUMENTS;
+        r_error->argument = method->args_required;
+        return;
+    }
+
+    if (p_argument_count > method->args_allowed && !method->vararg) {
+        r_error->error = GDEXTENSION_CALL_ERROR_TOO_MANY_ARGUMENTS;
+        r_error->argument = method->args_allowed;
+        return;
+    }
+
+    LuauEngine::PooledThread thread = LuauEngine::get_singleton()->acquire_thread(vm_type);
+    lua_State *ET = thread.L;
+
+    for (int i = 0; i < p_argument_count; i++) {
+        LuauBridge::push_variant(ET, *p_args[i]);
+    }
+
+    // Add default arguments
+    for (int i = p_argument_count; i < method->args_allowed; i++) {
+        LuauBridge::push_variant(ET, method->default_arguments[i - method->args_required]);
+    }
+
+    r_error->error = GDEXTENSION_CALL_OK;
+    int argc = MAX((int)p_argument_count, method->args_allowed);
+    int status = call_internal(p_method, method->index, ET, argc, 1);
+
+    if (status == LUA_OK) {
+        *r_return = LuauBridge::get_variant(ET, -1);
+    } else {
+        *r_return = Variant();
+        r_error->error = GDEXTENSION_CALL_ERROR_METHOD_NOT_CONST;
+    }
+
+    LuauEngine::get_singleton()->release_thread(vm_type, thread);
 }
 
 
@@ -724,7 +718,7 @@ void LuauScriptInstance::notification(int32_t p_what) {
         return;
     }
     
-	if (!script->definition.is_tool && Engine::get_singleton()->is_editor_hint()) {
+	if (skip_calls) {
 		return;
 	}
 
@@ -811,39 +805,23 @@ void LuauScriptInstance::notification(int32_t p_what) {
 
 	if (p_what > 10000) return;
 
-	lua_State *ET = lua_newthread(T);
-	
-	// Get the self table from the main state
-	lua_getref(L, self_ref);
-	lua_xmove(L, ET, 1);
-	
-	// Get the method from the self table
-	lua_getfield(ET, -1, "_notification");
-	
-	if (!lua_isfunction(ET, -1)) {
-		lua_pop(ET, 2); // Remove non-function and self table
-		lua_pop(T, 1); // Remove thread
+	script->update_dispatch();
+	if (!script->handles_notification(p_what)) {
+		LuauEngine::get_singleton()->count_skipped_notification(vm_type);
 		return;
 	}
+
+	LuauEngine::PooledThread thread = LuauEngine::get_singleton()->acquire_thread(vm_type);
+	lua_State *ET = thread.L;
 	
-	// Swap function and self table so self is first argument
-	lua_insert(ET, -2);
-	
-	// Push the notification code as argument
+	// Call: _notification(self, notification_code)
+	lua_getref(L, self_ref);
+	lua_xmove(L, ET, 1);
 	lua_pushinteger(ET, p_what);
+
+	call_internal(LuauLanguage::get_singleton()->notification_name, script->notification_index, ET, 2, 0);
 	
-	// Call: function, self, notification_code
-	int call_result = lua_pcall(ET, 2, 0, 0); // 1 for self + 1 for notification code
-	
-	if (call_result != LUA_OK) {
-		const char* error_msg = lua_tostring(ET, -1);
-		if (error_msg) {
-			UtilityFunctions::printerr(vformat("Luau script error in _notification: %s", error_msg));
-		}
-		lua_pop(ET, 1); // Remove error message
-	}
-	
-	lua_pop(T, 1); // Remove thread
+	LuauEngine::get_singleton()->release_thread(vm_type, thread);
 }
 
 void LuauScriptInstance::to_string(GDExtensionBool *r_is_valid, String *r_out) {
@@ -1114,6 +1092,10 @@ Variant::Type LuauScriptInstance::get_property_type(const StringName &p_name, bo
 }
 
 bool LuauScriptInstance::has_method(const StringName &p_name) const {
+    if (script->get_dispatch(p_name)) {
+        return true;
+    }
+
     // check self for runtime methods
     if (L && self_ref != LUA_NOREF) {
         lua_getref(L, self_ref);
@@ -1121,19 +1103,9 @@ bool LuauScriptInstance::has_method(const StringName &p_name) const {
         lua_getfield(L, -1, method_str.utf8().get_data());
         bool is_func = lua_isfunction(L, -1);
         lua_pop(L, 2); // Remove function/nil and self table
-        if (is_func) {
-            return true;
-        }
-    }
-    
-    // fall back to checking the script metadata
-    const LuauScript *s = script.ptr();
-    while (s) {
-        if (s->definition.methods.has(p_name)) {
-            return true;
-        }
-        s = s->base.ptr();
+        return is_func;
     }
+
     return false;
 }
 
@@ -1145,32 +1117,47 @@ Ref<LuauScript> LuauScriptInstance::get_script() const {
     return script;
 }
 
-int LuauScriptInstance::call_internal(const StringName &p_method, lua_State *ET, int argc, int retc) {
+int LuauScriptInstance::call_internal(const StringName &p_method, int p_index, lua_State *ET, int argc, int retc) {
     if (!L || !T || self_ref == LUA_NOREF) {
         return LUA_ERRRUN;
     }
-    
-    // Get the self table from the main state
-    lua_getref(L, self_ref);
-    lua_xmove(L, ET, 1);
-    
-    // Get the method from the self table
-    String method_str = String(p_method);
-    lua_getfield(ET, -1, method_str.utf8().get_data());
-    
-    if (!lua_isfunction(ET, -1)) {
-        lua_pop(ET, 2); // Remove non-function and self table
-        return LUA_ERRRUN;
+
+    if (dispatch_version != script->dispatch_version) {
+        cache_function_refs();
+    }
+
+    if (p_index >= 0 && p_index < (int)function_refs.size() && function_refs[p_index] != LUA_NOREF) {
+        lua_getref(L, function_refs[p_index]);
+        lua_xmove(L, ET, 1);
+        lua_insert(ET, -(argc + 1)); //move function below the arguments
+    } else {
+        // Not captured at creation (e.g. assigned later); look it up on self
+        lua_getref(L, self_ref);
+        lua_xmove(L, ET, 1);
+
+        String method_str = String(p_method);
+        lua_getfield(ET, -1, method_str.utf8().get_data());
+
+        if (!lua_isfunction(ET, -1)) {
+            lua_pop(ET, 2); // Remove non-function and self table
+            return LUA_ERRRUN;
+        }
+
+        lua_remove(ET, -2);	//remove self
+        lua_insert(ET, -(argc + 1)); //move function below the arguments
     }
-    
-    lua_remove(ET, -2);	//remove self
-	lua_insert(ET, -(argc + 1)); //move function to the top
     
     // The arguments are already on the stack, placed by the caller
     // So we have: function, self, [args...]
+    LuauEngine *engine = LuauEngine::get_singleton();
+    engine->begin_call(vm_type);
     int call_result = lua_pcall(ET, argc, retc, 0);
+    engine->end_call(vm_type);
     
-    if (call_result != LUA_OK) {
+    if (call_result == LUA_ERRMEM) {
+        UtilityFunctions::printerr(vformat("Luau script error in %s: VM memory limit of %d MB reached", p_method, int64_t(engine->get_heap_limit(vm_type) >> 20)));
+        lua_pop(ET, 1);
+    } else if (call_result != LUA_OK) {
         const char* error_msg = lua_tostring(ET, -1);
         if (error_msg) {
             UtilityFunctions::printerr(vformat("Luau script error in %s: %s", p_method, error_msg));
@@ -1189,19 +1176,261 @@ LuauScriptInstance::LuauScriptInstance(
 	script(p_script), 
 	owner(p_owner), 
 	vm_type(p_vmtype) {
+	skip_calls = !p_script->definition.is_tool && Engine::get_singleton()->is_editor_hint();
+}
+
+void LuauScriptInstance::cache_function_refs() {
+	clear_function_refs();
+
+	const LuauScript *s = script.ptr();
+	dispatch_version = s->dispatch_version;
+
+	if (!L || self_ref == LUA_NOREF) {
+		return;
+	}
+
+	function_refs.resize(s->dispatch_names.size());
+
+	lua_getref(L, self_ref);
+	for (uint32_t i = 0; i < function_refs.size(); i++) {
+		CharString name = String(s->dispatch_names[i]).utf8();
+		lua_rawgetfield(L, -1, name.get_data());
+		function_refs[i] = lua_isfunction(L, -1) ? lua_ref(L, -1) : LUA_NOREF;
+		lua_pop(L, 1);
+	}
+	lua_pop(L, 1); // self table
+}
+
+void LuauScriptInstance::clear_function_refs() {
+	if (L) {
+		for (int ref : function_refs) {
+			if (ref != LUA_NOREF) {
+				lua_unref(L, ref);
+			}
+		}
+	}
+	function_refs.clear();
+}
+
+#ifdef DEBUG_ENABLED
+// Copies p_from's upvalues into p_to's by name. Names are only in the bytecode
+// with debug level 2 (the debug profile); without them nothing is carried over.
+static int copy_upvalues_by_name(lua_State *L, int p_from, int p_to) {
+	p_from = lua_absindex(L, p_from);
+	p_to = lua_absindex(L, p_to);
+
+	int copied = 0;
+	for (int i = 1;; i++) {
+		const char *to_name = lua_getupvalue(L, p_to, i);
+		if (!to_name) {
+			break;
+		}
+		// Local functions are code too; the edited `local function helper` has to win
+		bool is_function = lua_isfunction(L, -1);
+		lua_pop(L, 1);
+
+		if (to_name[0] == '\0' || is_function) {
+			continue;
+		}
+
+		for (int j = 1;; j++) {
+			const char *from_name = lua_getupvalue(L, p_from, j);
+			if (!from_name) {
+				break;
+			}
+
+			if (strcmp(from_name, to_name) == 0) {
+				if (lua_isfunction(L, -1)) {
+					lua_pop(L, 1);
+					break;
+				}
+
+				lua_setupvalue(L, p_to, i);
+				copied++;
+				break;
+			}
+			lua_pop(L, 1);
+		}
+	}
+
+	return copied;
 }
 
+// Sets the environment of the Lua function at p_index, and of every function it reaches
+// through its upvalues, to the table on top of the stack.
+static void set_closure_env(lua_State *L, int p_index, int p_visited) {
+	p_index = lua_absindex(L, p_index);
+	if (lua_iscfunction(L, p_index)) {
+		return;
+	}
+
+	lua_pushvalue(L, p_index);
+	lua_rawget(L, p_visited);
+	bool visited = lua_toboolean(L, -1);
+	lua_pop(L, 1);
+	if (visited) {
+		return;
+	}
+
+	lua_pushvalue(L, p_index);
+	lua_pushboolean(L, true);
+	lua_rawset(L, p_visited);
+
+	lua_pushvalue(L, -1);
+	lua_setfenv(L, p_index);
+
+	for (int i = 1; lua_getupvalue(L, p_index, i); i++) {
+		if (lua_isfunction(L, -1)) {
+			lua_pushvalue(L, -2);
+			set_closure_env(L, -2, p_visited);
+			lua_pop(L, 1);
+		}
+		lua_pop(L, 1);
+	}
+}
+
+bool LuauScriptInstance::hot_patch() {
+	if (!L || self_ref == LUA_NOREF) {
+		return false;
+	}
+
+	String chunkname = script->get_path().is_empty() ? String(script->definition.name) : script->get_path();
+
+	// Scratch thread so a failing chunk can't leave anything on the instance thread
+	lua_State *PT = lua_newthread(L);
+
+	// The new chunk runs against a shadow table that reads through to self, so
+	// top-level assignments land in the shadow and never reset instance state.
+	lua_newtable(PT);
+	lua_newtable(PT);
+	lua_getref(PT, self_ref);
+	lua_setfield(PT, -2, "__index");
+	lua_setmetatable(PT, -2);
+	lua_setsafeenv(PT, -1, true);
+
+	if (!script->push_main_function(vm_type, PT, chunkname)) {
+		lua_pop(L, 1); // scratch thread
+		return false;
+	}
+
+	lua_pushvalue(PT, -2);
+	lua_setfenv(PT, -2);
+
+	LuauEngine *engine = LuauEngine::get_singleton();
+	engine->begin_call(vm_type);
+	int call_result = lua_pcall(PT, 0, 0, 0);
+	engine->end_call(vm_type);
+
+	if (call_result != LUA_OK) {
+		const char *error_msg = lua_tostring(PT, -1);
+		UtilityFunctions::printerr(vformat("Hot reload of %s failed, keeping the previous code: %s", chunkname, error_msg ? error_msg : "unknown error"));
+		lua_pop(L, 1); // scratch thread
+		return false;
+	}
+
+	int shadow = lua_gettop(PT);
+	int self = shadow + 1;
+	int visited = shadow + 2;
+	lua_getref(PT, self_ref);
+	lua_newtable(PT);
+
+	int patched = 0;
+	int upvalues = 0;
+
+	lua_pushnil(PT);
+	while (lua_next(PT, shadow) != 0) {
+		// Stack: shadow, self, visited, key, value
+		if (lua_type(PT, -2) != LUA_TSTRING) {
+			lua_pop(PT, 1);
+			continue;
+		}
+
+		if (lua_isfunction(PT, -1)) {
+			lua_pushvalue(PT, -2);
+			lua_rawget(PT, self);
+			if (lua_isfunction(PT, -1)) {
+				upvalues += copy_upvalues_by_name(PT, -1, -2);
+			}
+			lua_pop(PT, 1);
+
+			// Globals resolve against the live instance again, not the shadow; that
+			// includes the new local functions this one calls
+			lua_pushvalue(PT, self);
+			set_closure_env(PT, -2, visited);
+			lua_pop(PT, 1);
+
+			lua_pushvalue(PT, -2);
+			lua_insert(PT, -2);
+			lua_rawset(PT, self);
+			patched++;
+			continue;
+		}
+
+		// Fields added by the edit get their initial value; existing ones keep theirs
+		lua_pushvalue(PT, -2);
+		lua_rawget(PT, self);
+		bool exists = !lua_isnil(PT, -1);
+		lua_pop(PT, 1);
+
+		if (exists) {
+			lua_pop(PT, 1);
+		} else {
+			lua_pushvalue(PT, -2);
+			lua_insert(PT, -2);
+			lua_rawset(PT, self);
+		}
+	}
+
+	lua_pop(PT, 3); // visited, self, shadow
+	lua_pop(L, 1); // scratch thread
+
+	cache_function_refs();
+
+	print_verbose(vformat("Luau: hot patched %d functions (%d upvalues kept) on %s", patched, upvalues, chunkname));
+	return true;
+}
+#endif // DEBUG_ENABLED
+
 LuauScriptInstance::~LuauScriptInstance() {
-	// Clean up Lua state
-	if (L && thread_ref != LUA_NOREF) {
-		lua_unref(L, thread_ref);
-		thread_ref = LUA_NOREF;
+	if (script.is_valid() && owner && LuauLanguage::singleton) {
+		MutexLock lock(*LuauLanguage::singleton->mutex.ptr());
+		LuauScriptInstance **registered = script->instances.getptr(owner->get_instance_id());
+		if (registered && *registered == this) {
+			script->instances.erase(owner->get_instance_id());
+		}
 	}
-	
-	if (L && self_ref != LUA_NOREF) {
-		lua_unref(L, self_ref);
-		self_ref = LUA_NOREF;
+
+	// Clean up Lua state. Refs are released in the frame GC budget, so freeing
+	// a whole scene doesn't stall on thousands of unrefs.
+	LuauEngine *engine = LuauEngine::get_singleton();
+	if (L && engine) {
+		if (owner) {
+			engine->cancel_owned_tasks(vm_type, owner->get_instance_id());
+		}
+
+		// A task still running (it freed its own owner) must not reach the freed objects through self
+		if (self_ref != LUA_NOREF) {
+			lua_getref(L, self_ref);
+			if (lua_istable(L, -1)) {
+				lua_pushstring(L, "__godot_owner");
+				lua_pushnil(L);
+				lua_rawset(L, -3);
+				lua_pushstring(L, "__godot_script");
+				lua_pushnil(L);
+				lua_rawset(L, -3);
+			}
+			lua_pop(L, 1);
+		}
+
+		for (int ref : function_refs) {
+			engine->queue_unref(vm_type, ref);
+		}
+		engine->queue_unref(vm_type, thread_ref);
+		engine->queue_unref(vm_type, self_ref);
 	}
+	function_refs.clear();
+	thread_ref = LUA_NOREF;
+	self_ref = LUA_NOREF;
 	
 	L = nullptr;
 	T = nullptr;
@@ -1528,6 +1757,10 @@ String LuauScript::_get_source_code() const {
 }
 
 // MARK: LuauScript
+void LuauScript::_bind_methods() {
+    ClassDB::bind_method(D_METHOD("get_released_source_bytes"), &LuauScript::get_released_source_bytes);
+}
+
 void LuauScript::_set_source_code(const String &p_code) {
     source = p_code;
     source_changed_cache = true;
@@ -1535,6 +1768,7 @@ void LuauScript::_set_source_code(const String &p_code) {
     // Clear compilation state when source changes
     load_stage = LOAD_NONE;
     bytecode.clear();
+    clear_main_functions();
 }
 
 Error LuauScript::_reload(bool p_keep_state) {
@@ -1576,6 +1810,7 @@ Error LuauScript::_reload(bool p_keep_state) {
 	}
 
 	// Clear cached data to force recompilation
+	String previous_key = compiled_key;
 	load_stage = LOAD_NONE;
 	bytecode.clear();
 	
@@ -1597,16 +1832,20 @@ Error LuauScript::_reload(bool p_keep_state) {
 			}
 		}
 		
-		// Update regular instances if keeping state
-		if (p_keep_state) {
+		// Patch live instances in place when keeping state; an unchanged compile
+		// (same cache key) has nothing to swap.
+		if (p_keep_state && compiled_key != previous_key && bool(LuauEngine::get_project_setting("debug/hot_reload", true))) {
 			MutexLock lock(*LuauLanguage::singleton->mutex.ptr());
 			
+			int patched = 0;
 			for (const KeyValue<uint64_t, LuauScriptInstance *> &E : instances) {
 				LuauScriptInstance *instance = E.value;
-				if (instance) {
-					//MARK: TODO Hot Reload
+				if (instance && instance->hot_patch()) {
+					patched++;
 				}
 			}
+
+			print_verbose(vformat("Luau: hot reloaded %s into %d of %d instances", get_path(), patched, int(instances.size())));
 		}
 		
 		// Emit changed signal to notify the editor
@@ -1630,7 +1869,8 @@ bool LuauScript::_is_tool() const {
 }
 
 bool LuauScript::_is_valid() const {
-	if (source.is_empty()) {
+	// Lean loading may have released the source of a compiled script
+	if (source.is_empty() && bytecode.is_empty()) {
 		return false;
 	}
 	
@@ -1824,58 +2064,19 @@ Error LuauScript::load_source_code(const String &p_path) {
     return err;
 }
 
-Error LuauScript::load(LoadStage p_load_stage, bool p_force) {
-    if (!p_force && load_stage >= p_load_stage) {
-        return OK;
-    }
-    
-    if (source.is_empty()) {
-        ERR_FAIL_V_MSG(ERR_INVALID_DATA, "Script source is empty");
-    }
-    
-    Error err = OK;
-    
-    // Compile
-    if (p_load_stage >= LOAD_COMPILE) {
-        CharString utf8 = source.utf8();
-        std::string source_str(utf8.get_data(), utf8.length());
-		
-        Luau::CompileOptions compile_opts;
-        compile_opts.optimizationLevel = 2; // Full optimization
-        compile_opts.debugLevel = 2; // Full debug info
-        compile_opts.typeInfoLevel = 1; // Generate type info for all modules
-        compile_opts.coverageLevel = 0; // No coverage by default
-        
-        try {
-            std::string compiled = Luau::compile(source_str, compile_opts);
-            
-            bytecode.resize(compiled.size());
-            memcpy(bytecode.ptrw(), compiled.data(), compiled.size());
-            
-            load_stage = LOAD_COMPILE;
-
-        } catch (const Luau::CompileError &e) {
-            ERR_FAIL_V_MSG(ERR_COMPILATION_FAILED, 
-                vformat("Luau compilation failed at line %d: %s", 
-                    e.getLocation().begin.line + 1, e.what()));
-
-        } catch (...) {
-            ERR_FAIL_V_MSG(ERR_COMPILATION_FAILED, "Unknown compilation error");
+//MARK: compile pipeline
+Error LuauScript::compile_source(CompiledScript &r_script) {
+    // One UTF-8 conversion and one parse feed both the compiler and the metadata pass
+    CharString utf8 = r_script.source.utf8();
 
-        }
-    }
-    
-    // Parse and analyse
-    if (p_load_stage >= LOAD_ANALYSIS) {
-        CharString utf8 = source.utf8();
-        std::string source_str(utf8.get_data(), utf8.length());
-        
+    {
         Luau::Allocator allocator;
         Luau::AstNameTable names(allocator);
         
         Luau::ParseOptions parse_opts;
+        parse_opts.captureComments = true;
         Luau::ParseResult parse_result = Luau::Parser::parse(
-            source_str.c_str(), source_str.size(), names, allocator, parse_opts);
+            utf8.get_data(), utf8.length(), names, allocator, parse_opts);
         
         if (!parse_result.errors.empty()) {
             const auto &error = parse_result.errors[0];
@@ -1883,65 +2084,146 @@ Error LuauScript::load(LoadStage p_load_stage, bool p_force) {
                 vformat("Parse error at line %d: %s",
                     error.getLocation().begin.line + 1, error.getMessage().c_str()));
         }
+
+        // Compile, letting `--!profile <name>` override the project profile
+        String profile = r_script.profile;
+        for (const Luau::HotComment &hc : parse_result.hotcomments) {
+            if (hc.header && hc.content.rfind("profile ", 0) == 0) {
+                profile = String::utf8(hc.content.c_str() + 8).strip_edges();
+            }
+        }
+
+        try {
+            Luau::BytecodeBuilder bcb;
+            Luau::compileOrThrow(bcb, parse_result, names, get_compile_options(profile));
+
+            const std::string &compiled = bcb.getBytecode();
+            r_script.bytecode.resize(compiled.size());
+            memcpy(r_script.bytecode.ptrw(), compiled.data(), compiled.size());
+
+        } catch (const Luau::CompileError &e) {
+            ERR_FAIL_V_MSG(ERR_COMPILATION_FAILED, 
+                vformat("Luau compilation failed at line %d: %s", 
+                    e.getLocation().begin.line + 1, e.what()));
+
+        } catch (...) {
+            ERR_FAIL_V_MSG(ERR_COMPILATION_FAILED, "Unknown compilation error");
+
+        }
         
         // Extract from AST
         if (parse_result.root) {
-            definition.methods.clear();
-            definition.properties.clear();
-            definition.property_indices.clear();
-            definition.members.clear();
-            definition.member_indices.clear();
-            definition.signals.clear();
-            definition.constants.clear();
-            constants.clear();
+            r_script.definition.methods.clear();
+            r_script.definition.properties.clear();
+            r_script.definition.property_indices.clear();
+            r_script.definition.members.clear();
+            r_script.definition.member_indices.clear();
+            r_script.definition.signals.clear();
+            r_script.definition.constants.clear();
+            r_script.definition.notifications.clear();
+            r_script.definition.dependencies.clear();
+            r_script.constants.clear();
             
-            if (definition.name.is_empty()) {
-                String path = get_path();
+            if (r_script.definition.name.is_empty()) {
+                String path = r_script.path;
                 if (!path.is_empty()) {
-                    definition.name = path.get_file().get_basename();
+                    r_script.definition.name = path.get_file().get_basename();
                 }
             }
             
-            if (definition.extends.is_empty()) {
-                definition.extends = "RefCounted";
+            if (r_script.definition.extends.is_empty()) {
+                r_script.definition.extends = "RefCounted";
             }
 
             {
                 // MARK: Config annotations
-                PackedStringArray lines_packed = source.split("\n");
-                for (int i = 0; i < lines_packed.size(); i++) {
-                    String line = lines_packed[i];
-                    String trimmed = line.strip_edges();
+                // Only the comment header counts, i.e. comments before the first statement
+                unsigned int header_end = parse_result.root->body.size > 0 ? parse_result.root->body.data[0]->location.begin.line : UINT_MAX;
+
+                const char *text = utf8.get_data();
+                int64_t line_offset = 0;
+                unsigned int line = 0;
+
+                for (const Luau::Comment &c : parse_result.commentLocations) {
+                    if (c.location.begin.line >= header_end) {
+                        break;
+                    }
+
+                    // Block comments can't carry annotations
+                    if (c.type != Luau::Lexeme::Comment) {
+                        continue;
+                    }
+
+                    while (line < c.location.begin.line && line_offset < utf8.length()) {
+                        if (text[line_offset++] == '\n') {
+                            line++;
+                        }
+                    }
+
+                    String trimmed = String::utf8(text + line_offset + c.location.begin.column,
+                            c.location.end.column - c.location.begin.column).strip_edges();
+                    String comment = trimmed.substr(trimmed.begins_with("---") ? 3 : 2).strip_edges();
                     
-                    if (trimmed.begins_with("---") || trimmed.begins_with("--")) {
-                        String comment = trimmed.substr(trimmed.begins_with("---") ? 3 : 2).strip_edges();
-                        
-                        // @extends annotation
-                        if (comment.begins_with("@extends ")) {
-                            String base_class = comment.substr(9).strip_edges();
-                            if (!base_class.is_empty()) {
-                                definition.extends = base_class;
-                            }
+                    // @extends annotation
+                    if (comment.begins_with("@extends ")) {
+                        String base_class = comment.substr(9).strip_edges();
+                        if (!base_class.is_empty()) {
+                            r_script.definition.extends = base_class;
                         }
-                        // @class annotation
-                        else if (comment.begins_with("@class ")) {
-                            String class_name = comment.substr(7).strip_edges();
-                            if (!class_name.is_empty()) {
-                                definition.name = class_name; //MARK: TODO custom class
-                            }
+                    }
+                    // @class annotation
+                    else if (comment.begins_with("@class ")) {
+                        String class_name = comment.substr(7).strip_edges();
+                        if (!class_name.is_empty()) {
+                            r_script.definition.name = class_name; //MARK: TODO custom class
                         }
-                        // @tool annotation
-                        else if (comment == "@tool") {
-                            definition.is_tool = true;
+                    }
+                    // @tool annotation
+                    else if (comment == "@tool") {
+                        r_script.definition.is_tool = true;
+                    }
+                    // @notifications annotation, e.g. `--- @notifications NOTIFICATION_READY, 2001`
+                    // Names stay unresolved: a res:// base is only linked at LOAD_FULL, see build_dispatch()
+                    else if (comment.begins_with("@notifications ")) {
+                        for (const String &entry : comment.substr(15).split(",", false)) {
+                            String code = entry.strip_edges();
+                            if (!code.is_empty()) {
+                                r_script.definition.notifications.push_back(code);
+                            }
                         }
-
-                    } else if (!trimmed.is_empty() && !trimmed.begins_with("--")) {
-                        break;
                     }
                 }
             }
 
-			String class_name = definition.name;
+			String class_name = r_script.definition.name;
+
+            // MARK: Dependencies
+            {
+                // Any "res://….luau" literal counts, which covers require(), load() and preload() alike
+                struct ScriptReferenceVisitor : public Luau::AstVisitor {
+                    HashSet<String> paths;
+
+                    bool visit(Luau::AstExprConstantString *node) override {
+                        String value = String::utf8(node->value.data, node->value.size);
+                        if (value.begins_with("res://") && value.get_extension().to_lower() == luau::LUAUSCRIPT_EXTENSION) {
+                            paths.insert(value.simplify_path());
+                        }
+                        return false;
+                    }
+                };
+
+                ScriptReferenceVisitor visitor;
+                parse_result.root->visit(&visitor);
+
+                if (r_script.definition.extends.begins_with("res://")) {
+                    visitor.paths.insert(r_script.definition.extends.simplify_path());
+                }
+                visitor.paths.erase(r_script.path);
+
+                for (const String &dependency : visitor.paths) {
+                    r_script.definition.dependencies.push_back(dependency);
+                }
+            }
 
             // Ast for metadata
             for (Luau::AstStat* stat : parse_result.root->body) {
@@ -1986,8 +2268,8 @@ Error LuauScript::load(LoadStage p_load_stage, bool p_force) {
 						}
 
 						if (is_constant) {
-							constants[StringName(var_name)] = var_value;
-							definition.constants[StringName(var_name)] = var_value;
+							r_script.constants[StringName(var_name)] = var_value;
+							r_script.definition.constants[StringName(var_name)] = var_value;
 							continue;
 						}
 
@@ -2004,13 +2286,17 @@ Error LuauScript::load(LoadStage p_load_stage, bool p_force) {
 
 						var_def.default_value = var_value;
 						
-						WARN_PRINT(vformat(">> Type(%s) %s=%s (%s) native_type=%s",Variant::get_type_name(var_type), var_name, var_value, var_value.get_type_name(var_value.get_type()), native_type));
+						if (!r_script.lean) {
+							WARN_PRINT(vformat(">> Type(%s) %s=%s (%s) native_type=%s",Variant::get_type_name(var_type), var_name, var_value, var_value.get_type_name(var_value.get_type()), native_type));
+						}
 						
 						if (var_type == Variant::OBJECT) {
 							var_def.property.type = GDEXTENSION_VARIANT_TYPE_OBJECT;
 							var_def.property.hint_string = native_type;
 
-							if (ClassDB::is_parent_class(native_type, StringName("Resource"))) {
+							if (r_script.lean) {
+								// Hints only feed the inspector
+							} else if (ClassDB::is_parent_class(native_type, StringName("Resource"))) {
 								var_def.property.hint = PROPERTY_HINT_RESOURCE_TYPE;
 							} else if (ClassDB::is_parent_class(native_type, StringName("Node"))) {
 								var_def.property.hint = PROPERTY_HINT_NODE_TYPE;
@@ -2020,7 +2306,9 @@ Error LuauScript::load(LoadStage p_load_stage, bool p_force) {
 							var_def.property.type = GDEXTENSION_VARIANT_TYPE_ARRAY;
 							var_def.property.hint = PROPERTY_HINT_ARRAY_TYPE;
 		
-							if (ClassDB::is_parent_class(native_type, StringName("Resource"))) {
+							if (r_script.lean) {
+								// Hints only feed the inspector
+							} else if (ClassDB::is_parent_class(native_type, StringName("Resource"))) {
 								Array hint_values;
 								hint_values.resize(3);
 								hint_values[0] = Variant::OBJECT;
@@ -2159,13 +2447,15 @@ Error LuauScript::load(LoadStage p_load_stage, bool p_force) {
 							var_def.property.hint_string = "";
 						}
 
-						WARN_PRINT(vformat("%s hint_string=%s class_name=%s", var_name, var_def.property.hint_string, var_def.property.class_name));
+						if (!r_script.lean) {
+							WARN_PRINT(vformat("%s hint_string=%s class_name=%s", var_name, var_def.property.hint_string, var_def.property.class_name));
+						}
 
-						definition.members.push_back(var_def);
-						definition.member_indices[StringName(var_name)] = definition.members.size() - 1;
+						r_script.definition.members.push_back(var_def);
+						r_script.definition.member_indices[StringName(var_name)] = r_script.definition.members.size() - 1;
 						
-						definition.properties.push_back(var_def);
-						definition.property_indices[StringName(var_name)] = definition.properties.size() - 1;
+						r_script.definition.properties.push_back(var_def);
+						r_script.definition.property_indices[StringName(var_name)] = r_script.definition.properties.size() - 1;
                     }
                 }
                 // Local vars (e.g. local hello = "world")
@@ -2431,8 +2721,8 @@ Error LuauScript::load(LoadStage p_load_stage, bool p_force) {
                             if (has_value) {
                                 if (is_constant) {
 									// ALL_CAPS variables are constants
-									constants[StringName(var_name)] = var_value;
-									definition.constants[StringName(var_name)] = var_value;
+									r_script.constants[StringName(var_name)] = var_value;
+									r_script.definition.constants[StringName(var_name)] = var_value;
 								} else {
 									// Create the variable definition
 									GDClassProperty var_def;
@@ -2493,8 +2783,8 @@ Error LuauScript::load(LoadStage p_load_stage, bool p_force) {
 									}
 									
 									// Local variables go to members only (not accessible from outside)
-									definition.members.push_back(var_def);
-									definition.member_indices[StringName(var_name)] = definition.members.size() - 1;
+									r_script.definition.members.push_back(var_def);
+									r_script.definition.member_indices[StringName(var_name)] = r_script.definition.members.size() - 1;
 								}
                             }
                         }
@@ -2561,7 +2851,7 @@ Error LuauScript::load(LoadStage p_load_stage, bool p_force) {
                                     }
                                 }
                                 
-                                definition.methods[StringName(method_name)] = method;
+                                r_script.definition.methods[StringName(method_name)] = method;
                             }
                         }
                     }
@@ -2569,8 +2859,140 @@ Error LuauScript::load(LoadStage p_load_stage, bool p_force) {
             }
             
         }
-        
-        load_stage = LOAD_ANALYSIS;
+
+    return OK;
+}
+
+void LuauScript::apply_compiled(const CompiledScript &p_result) {
+    bytecode = p_result.bytecode;
+    clear_main_functions();
+
+    // Runtime-only fields survive; everything the analysis produces is replaced.
+    LuauScript *base_script = definition.base_script;
+    definition = p_result.definition;
+    definition.base_script = base_script;
+    constants = p_result.constants;
+
+    load_stage = LOAD_ANALYSIS;
+}
+
+String LuauScript::project_profile = "debug";
+bool LuauScript::project_lean = false;
+
+void LuauScript::snapshot_load_settings() {
+    project_profile = get_compile_profile(nobind::Engine::get_singleton()->is_editor_hint() || nobind::OS::get_singleton()->is_debug_build());
+
+    // Exported templates default to lean; the editor needs source and full hints
+    bool is_template = nobind::OS::get_singleton()->has_feature("template");
+    project_lean = LuauEngine::get_project_setting("runtime/lean_load", is_template);
+}
+
+String LuauScript::get_compile_profile(bool p_debug) {
+    String profile = LuauEngine::get_project_setting("compile/profile", "auto");
+
+    if (profile == "auto") {
+        return p_debug ? "debug" : "release";
+    }
+
+    if (profile != "debug" && profile != "profile" && profile != "release") {
+        WARN_PRINT(vformat("Unknown Luau compile profile '%s', using debug", profile));
+        return "debug";
+    }
+
+    return profile;
+}
+
+Luau::CompileOptions LuauScript::get_compile_options(const String &p_profile) {
+    Luau::CompileOptions compile_opts;
+    compile_opts.coverageLevel = 0; // No coverage by default
+
+    if (p_profile == "release") {
+        compile_opts.optimizationLevel = 2; // Full optimization, including inlining
+        compile_opts.debugLevel = 1; // Line info and function names for errors only
+        compile_opts.typeInfoLevel = 0; // Type info for native modules only
+    } else if (p_profile == "profile") {
+        compile_opts.optimizationLevel = 2;
+        compile_opts.debugLevel = 1; // Enough for sampling profilers
+        compile_opts.typeInfoLevel = 1;
+    } else {
+        compile_opts.optimizationLevel = 1; // No inlining, so stepping matches the source
+        compile_opts.debugLevel = 2; // Full debug info, including locals and upvalues
+        compile_opts.typeInfoLevel = 1; // Generate type info for all modules
+    }
+
+    // Vector3(x, y, z) becomes a builtin call producing a native vector
+    if (LuauBridge::is_native_vectors()) {
+        compile_opts.vectorCtor = "Vector3";
+        compile_opts.vectorType = "Vector3";
+    }
+
+    return compile_opts;
+}
+
+Error LuauScript::load(LoadStage p_load_stage, bool p_force) {
+    if (!p_force && load_stage >= p_load_stage) {
+        return OK;
+    }
+    
+    // Without source only a script that already has bytecode can finish loading
+    if (source.is_empty() && (p_force || bytecode.is_empty())) {
+        ERR_FAIL_V_MSG(ERR_INVALID_DATA, "Script source is empty");
+    }
+    
+    Error err = OK;
+
+    if (p_force) {
+        load_stage = LOAD_NONE;
+    }
+
+    // Unchanged sources reuse bytecode and class metadata from the cache
+    LuauCache *cache = LuauCache::get_singleton();
+    String cache_key;
+    bool analysed = false;
+    if (cache && p_load_stage >= LOAD_COMPILE && load_stage < LOAD_ANALYSIS) {
+        cache_key = LuauCache::get_cache_key(source);
+        compiled_key = cache_key;
+        if (cache->restore(cache_key, this)) {
+            clear_main_functions();
+            load_stage = LOAD_ANALYSIS;
+            analysed = true;
+        }
+    }
+    
+    // Compile and analyse
+    if (p_load_stage >= LOAD_COMPILE && load_stage < LOAD_ANALYSIS) {
+        CompiledScript result;
+        result.path = get_path();
+        result.source = source;
+        result.lean = is_lean_load();
+        result.profile = get_compile_profile();
+
+        uint64_t compile_start = nobind::Time::get_singleton()->get_ticks_usec();
+        err = compile_source(result);
+        if (cache) {
+            cache->record_compile(nobind::Time::get_singleton()->get_ticks_usec() - compile_start);
+        }
+
+        if (err != OK) {
+            return err;
+        }
+
+        apply_compiled(result);
+        analysed = true;
+
+        if (cache) {
+            cache->store(cache_key, this);
+        }
+    }
+
+    if (cache && analysed && !get_path().is_empty()) {
+        cache->update_dependencies(get_path(), definition.dependencies);
+    }
+
+    // Scripts backed by a file can always be re-read, so runtime builds keep only the bytecode
+    if (load_stage >= LOAD_ANALYSIS && !source.is_empty() && !get_path().is_empty() && is_lean_load()) {
+        released_source_bytes += source.length() * sizeof(char32_t);
+        source = String();
     }
     
     // Link and validate
@@ -2612,6 +3034,8 @@ Error LuauScript::load(LoadStage p_load_stage, bool p_force) {
             // Properties are validated during registration
         }
         
+        build_dispatch();
+
         load_stage = LOAD_FULL;
         
 #ifdef TOOLS_ENABLED
@@ -2663,6 +3087,134 @@ StringName LuauScript::_get_instance_base_type() const {
 }
 
 
+//MARK: method dispatch
+SafeNumeric<uint32_t> LuauScript::dispatch_counter;
+
+void LuauScript::build_dispatch() {
+	dispatch.clear();
+	dispatch_names.clear();
+	dispatch_version = dispatch_counter.increment();
+	notification_index = -1;
+	notification_filter.clear();
+
+	// Derived methods shadow base ones, so walk from the most derived script down
+	const LuauScript *s = this;
+	while (s) {
+		for (const KeyValue<StringName, GDMethod> &E : s->definition.methods) {
+			if (dispatch.has(E.key)) {
+				continue;
+			}
+
+			const GDMethod &method = E.value;
+
+			MethodDispatch entry;
+			entry.index = dispatch_names.size();
+			entry.args_allowed = method.arguments.size();
+			entry.args_required = MAX(0, entry.args_allowed - (int)method.default_arguments.size());
+			entry.vararg = method.flags.has_flag(METHOD_FLAG_VARARG);
+			entry.default_arguments = method.default_arguments;
+
+			dispatch.insert(E.key, entry);
+			dispatch_names.push_back(E.key);
+		}
+		s = s->base.ptr();
+	}
+
+	if (const MethodDispatch *notification = dispatch.getptr(LuauLanguage::get_singleton()->notification_name)) {
+		notification_index = notification->index;
+	}
+
+	if (notification_index < 0) {
+		return;
+	}
+
+	// The filter belongs to the script whose _notification the dispatch resolved to. Derived
+	// scripts may add codes to it but never drop ones it names; no filter there means every code.
+	const LuauScript *handler = this;
+	while (!handler->definition.methods.has(LuauLanguage::get_singleton()->notification_name)) {
+		handler = handler->base.ptr();
+	}
+
+	if (handler->definition.notifications.is_empty()) {
+		return;
+	}
+
+	// @notifications names are constants of the native class at the bottom of the chain
+	StringName native_base = _get_instance_base_type();
+	for (s = this; s != handler->base.ptr(); s = s->base.ptr()) {
+		for (const String &code : s->definition.notifications) {
+			if (code.is_valid_int()) {
+				notification_filter.insert(code.to_int());
+			} else if (native_base != StringName() && nobind::ClassDB::get_singleton()->class_has_integer_constant(native_base, code)) {
+				notification_filter.insert(nobind::ClassDB::get_singleton()->class_get_integer_constant(native_base, code));
+			} else {
+				WARN_PRINT(vformat("Unknown notification '%s' in @notifications of %s", code, s->get_path()));
+			}
+		}
+	}
+}
+
+void LuauScript::update_dispatch() {
+	for (const LuauScript *s = base.ptr(); s; s = s->base.ptr()) {
+		if (s->dispatch_version > dispatch_version) {
+			build_dispatch();
+			return;
+		}
+	}
+}
+
+//MARK: main function cache
+bool LuauScript::push_main_function(LuauEngine::VMType p_type, lua_State *T, const String &p_chunkname) const {
+	LuauEngine *engine = LuauEngine::get_singleton();
+	lua_State *L = engine->get_vm(p_type);
+
+	if (main_function_refs[p_type] == LUA_NOREF) {
+		if (bytecode.is_empty()) {
+			return false;
+		}
+
+		CharString chunkname = p_chunkname.utf8();
+		int load_result = luau_load(L, chunkname.get_data(), (const char *)bytecode.ptr(), bytecode.size(), 0);
+		if (load_result != 0) {
+			ERR_PRINT(vformat("Failed to load bytecode for %s: %s", p_chunkname, lua_tostring(L, -1)));
+			lua_pop(L, 1);
+			return false;
+		}
+
+		engine->compile_native(p_type, L, -1, p_chunkname);
+
+		main_function_refs[p_type] = lua_ref(L, -1);
+		lua_pop(L, 1);
+	}
+
+	// Each instance gets its own closure (and environment) over the shared prototype.
+	lua_getref(T, main_function_refs[p_type]);
+	lua_clonefunction(T, -1);
+	lua_remove(T, -2);
+
+	return true;
+}
+
+void LuauScript::clear_main_functions() {
+	LuauEngine *engine = LuauEngine::get_singleton();
+
+	for (int i = 0; i < LuauEngine::VM_MAX; i++) {
+		if (main_function_refs[i] == LUA_NOREF) {
+			continue;
+		}
+
+		// Scripts may be (re)loaded on resource loader threads, so the VM is only touched from the frame flush
+		if (engine) {
+			engine->queue_unref(LuauEngine::VMType(i), main_function_refs[i]);
+		}
+		main_function_refs[i] = LUA_NOREF;
+	}
+}
+
+LuauScript::~LuauScript() {
+	clear_main_functions();
+}
+
 //MARK: initialize_lua_state
 void LuauScriptInstance::initialize_lua_state(lua_State *p_L, lua_State *p_thread, int p_thread_ref, int p_self_ref) {
 	L = p_L;
@@ -2783,14 +3335,9 @@ void *LuauScript::_instance_create(Object *obj_ptr) const {
 			script_instance->initialize_lua_state(L, thread, thread_ref, self_ref);
 			
 			if (bytecode.size() > 0) {
-				int load_result = luau_load(
-					thread, 
-					script_name.utf8().get_data(), 
-					(const char*) bytecode.ptr(), 
-					bytecode.size(), 
-					0);
+				bool loaded = push_main_function(vm_type, thread, script_name);
 				
-				if (load_result == 0) {
+				if (loaded) {
 // MARK: setup script env
 					// The loaded function is now on the stack
 					// Get the self table to use as environment
@@ -2816,12 +3363,39 @@ void *LuauScript::_instance_create(Object *obj_ptr) const {
 							return 1; // Found in table
 						}
 						lua_pop(L, 1); // Remove nil
-						
+
+						// "self" is the owner object
+						if (strcmp(key, "self") == 0) {
+							lua_getfield(L, 1, "__godot_owner");
+							Object *owner_obj = (Object*)lua_touserdata(L, -1);
+							lua_pop(L, 1);
+
+							LuauBridge::push_variant(L, owner_obj);
+							return 1;
+						}
+
+						// Class tables are built once per VM and reused
+						lua_getfield(L, LUA_REGISTRYINDEX, LuauEngine::CLASS_CACHE_KEY);
+						lua_pushvalue(L, 2);
+						lua_rawget(L, -2);
+						if (!lua_isnil(L, -1)) {
+							lua_remove(L, -2); // Pop cache
+							return 1;
+						}
+						lua_pop(L, 1); // Pop nil, keep cache
+
 						if (nobind::ClassDB::get_singleton()->class_exists(key)) {
 							LuauEngine::singleton->register_and_push_godot_class(L, key);
+							lua_setreadonly(L, -1, true); // Shared by every instance
+							lua_pushvalue(L, 2);
+							lua_pushvalue(L, -2);
+							lua_rawset(L, -4); // cache[key] = class
+							lua_remove(L, -2); // Pop cache
 							return 1;
+						}
+						lua_pop(L, 1); // Pop cache
 
-						} else if (is_variant_type(key)) {
+						if (is_variant_type(key)) {
 							// Check if key is registered variant type
 							lua_getglobal(L, key);
 							if (!lua_isnil(L, -1)) {
@@ -2846,13 +3420,7 @@ void *LuauScript::_instance_create(Object *obj_ptr) const {
 						lua_getfield(L, 1, "__godot_script");
 						LuauScriptInstance *instance = (LuauScriptInstance*)lua_touserdata(L, -1);
 						lua_pop(L, 1);
-						
-						// Special handling for "self" - return the table itself
-						if (strcmp(key, "self") == 0) {
-							//lua_pushvalue(L, 1); // Push the env_table (which is self)
-							LuauBridge::push_variant(L, owner_obj);
-							return 1;
-						}
+
 
 						// Check if we're already getting a property to avoid recursion
 						if (instance && instance->getting_property) {
@@ -2907,10 +3475,8 @@ void *LuauScript::_instance_create(Object *obj_ptr) const {
 											args.append(LuauBridge::get_variant(L, i));
 										}
 
-										void** proxy = (void**)lua_newuserdata(L, sizeof(void*));
+										void** proxy = (void**)lua_newuserdatataggedwithmetatable(L, sizeof(void*), LuauBridge::UDTAG_ON_READY);
 										*proxy = nullptr;
-										luaL_getmetatable(L, "OnReadyWrapper");
-										lua_setmetatable(L, -2);
 
 										LambdaWrapper *wrapper = memnew(LambdaWrapper);
 
@@ -3067,12 +3633,20 @@ void *LuauScript::_instance_create(Object *obj_ptr) const {
 					// Set the combined metatable on self
 					lua_setmetatable(thread, -2);
 					
+					// Mark the environment safe so the chunk keeps GETIMPORT and builtin
+					// fastcalls. Imports are resolved against the sandboxed globals at
+					// load time, so those take precedence over same-named owner members;
+					// everything else still goes through __index above.
+					lua_setsafeenv(thread, -1, true);
+
 					// Set self table as the environment for the loaded function
 					lua_setfenv(thread, -2);
 					
 
 					// Execute the script with no arguments
+					LuauEngine::get_singleton()->begin_call(vm_type);
 					int call_result = lua_pcall(thread, 0, 0, 0);
+					LuauEngine::get_singleton()->end_call(vm_type);
 					
 					if (call_result != 0) {
 						WARN_PRINT(vformat("Script execution failed for: %s", script_name));
@@ -3118,14 +3692,7 @@ void *LuauScript::_instance_create(Object *obj_ptr) const {
 						lua_pop(thread, 1); // Remove error message
 #ifdef TOOLS_ENABLED
 						// In the editor, clean up and create a placeholder instance instead
-						// Clean up the failed instance
-						if (L && thread_ref != LUA_NOREF) {
-							lua_unref(L, thread_ref);
-						}
-						if (L && self_ref != LUA_NOREF) {
-							lua_unref(L, self_ref);
-						}
-						
+						// Clean up the failed instance; its destructor releases the thread and self refs
 						// Remove the failed instance from the instances map
 						{
 							MutexLock lock(*LuauLanguage::singleton->mutex.ptr());
@@ -3142,6 +3709,8 @@ void *LuauScript::_instance_create(Object *obj_ptr) const {
 						return _placeholder_instance_create(obj_ptr);
 #endif // TOOLS_ENABLED
 					} else {
+						script_instance->cache_function_refs();
+
 						// Get the self table from main state
 						lua_getref(L, script_instance->get_self_ref());
 						lua_xmove(L, thread, 1);
@@ -3177,7 +3746,9 @@ void *LuauScript::_instance_create(Object *obj_ptr) const {
                             lua_insert(thread, -2); // Move function below self_copy
                             // Stack: self_table, _init_function, self_table_copy
                             // Now call with self_table_copy as first argument
+                            LuauEngine::get_singleton()->begin_call(vm_type);
                             int init_result = lua_pcall(thread, 1, 0, 0); // 1 argument (self)
+                            LuauEngine::get_singleton()->end_call(vm_type);
 							
 							if (init_result != 0) {
 								const char* error_msg = lua_tostring(thread, -1);
@@ -3330,12 +3901,17 @@ Array LuauLanguage::get_scripts() const {
 #endif //TOOLS_ENABLED
 
 void LuauLanguage::_init() {
+    LuauScript::snapshot_load_settings();
+
     luau = memnew(LuauEngine);
     cache = memnew(LuauCache);
 
+    register_monitors();
 }
 
 void LuauLanguage::_finish() {
+    unregister_monitors();
+
     if (luau) {
         memdelete(luau);
     }
@@ -3344,6 +3920,62 @@ void LuauLanguage::_finish() {
     }
 }
 
+//MARK: Monitors
+Variant LuauLanguage::get_monitor(const String &p_stat) {
+	if (!singleton || !singleton->luau) {
+		return 0;
+	}
+
+	return singleton->get_stats().get(p_stat, 0);
+}
+
+Dictionary LuauLanguage::get_stats() const {
+	Dictionary result = luau ? luau->get_stats() : Dictionary();
+
+	if (cache) {
+		Dictionary cache_stats = cache->get_stats();
+		Array keys = cache_stats.keys();
+		for (int i = 0; i < keys.size(); i++) {
+			result["cache_" + String(keys[i])] = cache_stats[keys[i]];
+		}
+	}
+
+	return result;
+}
+
+void LuauLanguage::register_monitors() {
+	Performance *performance = Performance::get_singleton();
+	Array stats = get_stats().keys();
+
+	for (int i = 0; i < stats.size(); i++) {
+		String stat = stats[i];
+		StringName id = "Luau/" + stat;
+		if (performance->has_custom_monitor(id)) {
+			continue;
+		}
+
+		Array args;
+		args.push_back(stat);
+		performance->add_custom_monitor(id, callable_mp_static(&LuauLanguage::get_monitor), args);
+	}
+}
+
+void LuauLanguage::unregister_monitors() {
+	if (!luau) {
+		return;
+	}
+
+	Performance *performance = Performance::get_singleton();
+	Array stats = get_stats().keys();
+
+	for (int i = 0; i < stats.size(); i++) {
+		StringName id = "Luau/" + String(stats[i]);
+		if (performance->has_custom_monitor(id)) {
+			performance->remove_custom_monitor(id);
+		}
+	}
+}
+
 PackedStringArray LuauLanguage::_get_reserved_words() const {
     static const char *_reserved_words[] = {
 		"and",
@@ -3468,58 +4100,54 @@ end
 #endif
 }
 
-struct LuauScriptDepSort {
-	bool operator()(const Ref<LuauScript> &a, const Ref<LuauScript> &b) const {
-		if (a == b) return false;
-
-		const LuauScript *i = b->get_base().ptr();
-		while (i) {
-			if (i == a.ptr()) return true;
-			
-			i = i->get_base().ptr();
+void LuauLanguage::_reload_all_scripts() {
+#ifdef TOOLS_ENABLED
+	Array scripts = get_scripts();
+
+	// Scripts loaded through the cache are not always in script_list
+	if (LuauCache::get_singleton()) {
+		Array cached = LuauCache::get_singleton()->get_scripts();
+		for (int i = 0; i < cached.size(); i++) {
+			if (!scripts.has(cached[i])) {
+				scripts.push_back(cached[i]);
+			}
 		}
-
-		return false;
 	}
-};
 
-void LuauLanguage::_reload_all_scripts() {
-#ifdef TOOLS_ENABLED
-	_reload_scripts(get_scripts(), true);
+	_reload_scripts(scripts, true);
 #endif // TOOLS_ENABLED
 }
 
 void LuauLanguage::_reload_scripts(const Array &p_scripts, bool p_soft_reload) {
 #ifdef TOOLS_ENABLED
-	List<Ref<LuauScript>> scripts;
-
-	{
-		MutexLock lock(*this->mutex.ptr());
-
-		const SelfList<LuauScript> *item = script_list.first();
-
-		while (item) {
-			Ref<LuauScript> src = Ref<LuauScript>(item->self());
-			WARN_PRINT(vformat("Reload check: %s", src->get_path()));
-			if (src->is_root_script() && !src->get_path().is_empty()) {
-				scripts.push_back(src);
-			}
-			item = item->next();
-		}
-	}
-
-	scripts.sort_custom<LuauScriptDepSort>();
+	LuauCache *cache = LuauCache::get_singleton();
+	ERR_FAIL_NULL(cache);
 
+	// Only the given scripts and their dependents are reloaded, each after its own dependencies
+	PackedStringArray changed;
+	HashMap<String, Ref<LuauScript>> given;
 	for (int i = 0; i < p_scripts.size(); i++) {
 		Ref<LuauScript> script = p_scripts[i];
-		scripts.push_back(script);
+		if (script.is_valid() && !script->get_path().is_empty()) {
+			changed.push_back(script->get_path());
+			given[script->get_path()] = script;
+		}
 	}
-	
+
 	HashMap<Ref<LuauScript>, HashMap<ObjectID, List<Pair<StringName, Variant>>>> to_reload;
 
-	for (Ref<LuauScript> &script : scripts) {
-		bool skip = p_scripts.has(script) || to_reload.has(script->get_base());
-		if (!skip) continue;
+	for (const String &path : cache->get_reload_order(changed)) {
+		Ref<LuauScript> script;
+		if (given.has(path)) {
+			script = given[path];
+		} else {
+			Error err;
+			script = cache->get_script(path, err, false, LuauScript::LOAD_NONE);
+		}
+
+		if (script.is_null()) {
+			continue;
+		}
 
 		to_reload.insert(script, HashMap<ObjectID, List<Pair<StringName, Variant>>>());
 
@@ -3528,6 +4156,18 @@ void LuauLanguage::_reload_scripts(const Array &p_scripts, bool p_soft_reload) {
 		}
 	}
 	
+	// Compile everything up front on worker threads; each reload below then restores from the cache.
+	if (to_reload.size() > 1) {
+		PackedStringArray paths;
+		for (const KeyValue<Ref<LuauScript>, HashMap<ObjectID, List<Pair<StringName, Variant>>>> &E : to_reload) {
+			if (!E.key->get_path().is_empty()) {
+				paths.push_back(E.key->get_path());
+			}
+		}
+
+		cache->compile_batch(paths, false);
+	}
+
 	for (KeyValue<Ref<LuauScript>, HashMap<ObjectID, List<Pair<StringName, Variant>>>> &E : to_reload) {
 		Ref<LuauScript> scr = E.key;
 		
@@ -3543,7 +4183,7 @@ void LuauLanguage::_reload_scripts(const Array &p_scripts, bool p_soft_reload) {
 			scr->load_source_code(path);
 		}
 
-		scr->reload();
+		scr->reload(p_soft_reload);
 
 		//restore state if saved
 		for (KeyValue<ObjectID, List<Pair<StringName, Variant>>> &F : E.value) {
@@ -3994,6 +4634,56 @@ void LuauLanguage::_frame() {
 		delta = (new_ticks - ticks_usec) / 1e6f;
 
 	ticks_usec = new_ticks; 
+
+	if (luau) {
+		luau->begin_frame();
+		luau->resume_tasks();
+		luau->step_gc(get_frame_headroom_usec());
+	}
+
+	// Sleeping tasks also wake on physics ticks; the tree only exists once the main loop runs.
+	if (!physics_frame_connected) {
+		SceneTree *tree = nobind::Object::cast_to<SceneTree>(nobind::Engine::get_singleton()->get_main_loop());
+		if (tree) {
+			tree->connect("physics_frame", callable_mp(this, &LuauLanguage::physics_frame));
+			physics_frame_connected = true;
+		}
+	}
+}
+
+uint64_t LuauLanguage::get_frame_headroom_usec() {
+	// With vsync or an FPS cap every frame lasts the target time however little work it did,
+	// so idleness is what's left of the target after this frame's process and physics work.
+	double target = 0.0;
+	int max_fps = nobind::Engine::get_singleton()->get_max_fps();
+	if (max_fps > 0) {
+		target = 1.0 / max_fps;
+	} else {
+		DisplayServer *display = DisplayServer::get_singleton();
+		if (display && display->window_get_vsync_mode() != DisplayServer::VSYNC_DISABLED) {
+			if (refresh_rate == 0.0) {
+				refresh_rate = display->screen_get_refresh_rate(); // Queries the OS, so only once
+			}
+			if (refresh_rate > 0.0) {
+				target = 1.0 / refresh_rate;
+			}
+		}
+	}
+
+	// Uncapped frames have no deadline to leave room before
+	if (target <= 0.0) {
+		return 0;
+	}
+
+	Performance *performance = Performance::get_singleton();
+	double work = performance->get_monitor(Performance::TIME_PROCESS) + performance->get_monitor(Performance::TIME_PHYSICS_PROCESS);
+	return work < target ? uint64_t((target - work) * 1e6) : 0;
+}
+
+void LuauLanguage::physics_frame() {
+	if (luau) {
+		luau->resume_tasks();
+	}
 }
 
 bool LuauLanguage::_handles_global_class_type(const String &p_type) const {
@@ -6,6 +6,9 @@
 #include <godot_cpp/classes/script_extension.hpp>
 #include <godot_cpp/classes/script_language_extension.hpp>
 #include <godot_cpp/templates/hash_map.hpp>
+#include <godot_cpp/templates/hash_set.hpp>
+#include <godot_cpp/templates/local_vector.hpp>
+#include <godot_cpp/templates/safe_refcount.hpp>
 #include <godot_cpp/classes/multiplayer_api.hpp>
 #include <godot_cpp/classes/multiplayer_peer.hpp>
 #include <godot_cpp/templates/self_list.hpp>
@@ -19,6 +22,7 @@
 namespace Luau {
 	struct AstExpr;
 	struct AstType;
+	struct CompileOptions;
 }
 
 namespace godot {
@@ -128,6 +132,8 @@ namespace godot {
         HashMap<StringName, GDMethod> signals;
         HashMap<StringName, GDRpc> rpcs;
         HashMap<StringName, int> constants;
+        PackedStringArray notifications; // Entries of @notifications, names or codes; resolved in build_dispatch()
+        PackedStringArray dependencies; // res:// scripts this one extends, requires or references
     
         int set_prop(const String &p_name, const GDClassProperty &p_prop);
     };
@@ -184,7 +190,17 @@ namespace godot {
         int thread_ref = LUA_NOREF; // Reference to keep thread alive
         int self_ref = LUA_NOREF; // Reference to self table
         
-        int call_internal(const StringName &p_method, lua_State *ET, int argc, int retc);
+        // Registry refs to the script's methods, indexed like LuauScript::dispatch_names.
+        // Captured after the chunk runs and after hot patches only: a method the script
+        // later reassigns on self (`self.foo = fn`) is seen by Lua callers, not by engine calls.
+        LocalVector<int> function_refs;
+        uint32_t dispatch_version = 0;
+
+        // Non-tool scripts don't run in the editor; decided once at creation.
+        bool skip_calls = false;
+
+        int call_internal(const StringName &p_method, int p_index, lua_State *ET, int argc, int retc);
+        void clear_function_refs();
         
     public:
         // Recursion guard for property access (needs to be public for lambda access)
@@ -214,6 +230,15 @@ namespace godot {
     // Initialize the Lua state for this instance
     void initialize_lua_state(lua_State *p_L, lua_State *p_thread, int p_thread_ref, int p_self_ref);
     int get_self_ref() const { return self_ref; }
+
+    // Captures the script's methods from the self table after the chunk has run.
+    void cache_function_refs();
+
+#ifdef DEBUG_ENABLED
+    // Re-runs the reloaded chunk against this instance and swaps its functions in
+    // place, keeping field values and same-named upvalues. False leaves the old code.
+    bool hot_patch();
+#endif
     
     LuauScriptInstance(const Ref<LuauScript> &p_script, Object *p_owner, LuauEngine::VMType p_vmtype);
     ~LuauScriptInstance();
@@ -277,10 +302,24 @@ namespace godot {
             LOAD_FULL,
         };
 
+        // Output of the compile + analysis pipeline. Filling one touches no VM or
+        // script object, so it can run on worker threads.
+        struct CompiledScript {
+            String path;
+            String source;
+
+            PackedByteArray bytecode;
+            GDClassDefinition definition;
+            HashMap<StringName, Variant> constants;
+
+            bool lean = false; // Skip analysis only the editor needs (inspector hints, logging)
+            String profile; // Compile profile; a `--!profile` hot comment in the source wins
+        };
+
     protected:
         LoadStage load_stage = LOAD_NONE;
 
-        static void _bind_methods() {};
+        static void _bind_methods();
         
     private:
         Ref<LuauScript> base;
@@ -288,11 +327,40 @@ namespace godot {
         String source;
         bool source_changed_cache;
         PackedByteArray bytecode;
+        uint64_t released_source_bytes = 0;
+        String compiled_key; // LuauCache entry the bytecode came from
 
         GDClassDefinition definition;
         HashMap<StringName, Variant> constants;
 
         HashMap<uint64_t, LuauScriptInstance *> instances;
+
+        // Project load settings, see snapshot_load_settings()
+        static String project_profile;
+        static bool project_lean;
+
+    public:
+        // Flattened view of the methods callable from the engine, built at LOAD_FULL.
+        struct MethodDispatch {
+            int index = 0; // Slot in dispatch_names and instance function refs
+            int args_required = 0;
+            int args_allowed = 0;
+            bool vararg = false;
+            Vector<Variant> default_arguments;
+        };
+
+    private:
+        HashMap<StringName, MethodDispatch> dispatch;
+        Vector<StringName> dispatch_names;
+        uint32_t dispatch_version = 0; // From dispatch_counter, so a base rebuilt later has a higher one
+        static SafeNumeric<uint32_t> dispatch_counter;
+        int notification_index = -1; // Dispatch slot of _notification, -1 when the script has none
+        HashSet<int> notification_filter; // Resolved @notifications; empty forwards every code to _notification
+
+        void build_dispatch();
+
+        // Registry refs to the loaded main function, one per VM. Instances clone it instead of reloading bytecode.
+        mutable int main_function_refs[LuauEngine::VM_MAX] = { LUA_NOREF, LUA_NOREF, LUA_NOREF };
         
 #ifdef TOOLS_ENABLED
         HashMap<uint64_t, PlaceHolderScriptInstance *> placeholders;
@@ -307,6 +375,32 @@ namespace godot {
         Error load_source_code(const String &p_path);
         Error load(LoadStage p_load_stage, bool p_force = false);
 
+        // Reads luau/compile/profile and luau/runtime/lean_load. Called on the main thread
+        // when the language starts; loader threads only see the snapshot.
+        static void snapshot_load_settings();
+
+        // Compile profiles are "debug", "profile" and "release". The project default
+        // comes from luau/compile/profile.
+        static String get_compile_profile() { return project_profile; }
+        // As above, for a debug or release build other than the running one (exports).
+        // Reads ProjectSettings, so main thread only.
+        static String get_compile_profile(bool p_debug);
+        // Options a profile compiles with; part of the bytecode cache key.
+        static Luau::CompileOptions get_compile_options(const String &p_profile);
+
+        // Runtime builds skip editor-only analysis and release source once compiled.
+        static bool is_lean_load() { return project_lean; }
+        // Bytes of source text freed by lean loading.
+        uint64_t get_released_source_bytes() const { return released_source_bytes; }
+
+        // Compiles and analyses r_script.source into r_script. Thread-safe.
+        static Error compile_source(CompiledScript &r_script);
+        // Publishes a pipeline result; main thread only.
+        void apply_compiled(const CompiledScript &p_result);
+
+        bool push_main_function(LuauEngine::VMType p_type, lua_State *T, const String &p_chunkname) const;
+        void clear_main_functions();
+
         // AST value extraction helpers
         static Variant::Type parse_type_name(const String& type_name);
         static AstExprResult extract_ast_expr_value(
@@ -316,6 +410,12 @@ namespace godot {
         );
 
         const GDClassDefinition &get_definition() const { return definition; }
+        const MethodDispatch *get_dispatch(const StringName &p_method) const { return dispatch.getptr(p_method); }
+        // Rebuilds the dispatch table if a base script rebuilt its own since (base reloaded).
+        void update_dispatch();
+        bool handles_notification(int32_t p_what) const {
+            return notification_index >= 0 && (notification_filter.is_empty() || notification_filter.has(p_what));
+        }
         Ref<LuauScript> get_base() const { return base; }
         bool is_root_script() const { return _owner == nullptr; }
 
@@ -365,6 +465,8 @@ namespace godot {
         bool can_instantiate() const;
 
         void update_exports_internal(PlaceHolderScriptInstance *p_instance) const;
+
+        ~LuauScript();
     };
 
 
@@ -381,6 +483,12 @@ namespace godot {
         LuauCache *cache = nullptr;
 
         uint64_t ticks_usec = 0;
+        bool physics_frame_connected = false;
+        void physics_frame();
+
+        double refresh_rate = 0.0; // Of the screen, fetched on first use; negative if unknown
+        // Time left before the frame's deadline, 0 when uncapped or over time.
+        uint64_t get_frame_headroom_usec();
         
         SelfList<LuauScript>::List script_list;
 
@@ -436,12 +544,22 @@ namespace godot {
         // static bool ar_to_si(lua_Debug &p_ar, DebugInfo::StackInfo &p_si);
 #endif // TOOLS_ENABLED
 
+        // Exposes get_stats() as debugger monitors under "Luau/".
+        static Variant get_monitor(const String &p_stat);
+        void register_monitors();
+        void unregister_monitors();
+
     protected:
         static void _bind_methods() {};
 
     public:
         HashMap<StringName, Variant> global_constants;
+        const StringName ready_name = "_ready";
+        const StringName notification_name = "_notification";
         static LuauLanguage *get_singleton() { return singleton; };
+
+        // Engine counters plus LuauCache counters prefixed with "cache_".
+        Dictionary get_stats() const;
         
 #ifdef TOOLS_ENABLED
         Array get_scripts() const;
@@ -15,7 +15,9 @@
 #include "luauscript_syntax_highlighter.h"
 #include "luau_engine.h"
 #include "luau_script.h"
+#include "luau_cache.h"
 #include "luau_plugin.h"
+#include "luau_export_plugin.h"
 #include "lamda_wrapper.h"
 
 using namespace godot;
@@ -28,6 +30,7 @@ void initialize_luau_module(ModuleInitializationLevel p_level) {
     if (p_level == MODULE_INITIALIZATION_LEVEL_SERVERS) {
         GDREGISTER_INTERNAL_CLASS(LambdaWrapper);
         GDREGISTER_INTERNAL_CLASS(LuaFunctionWrapper);
+        GDREGISTER_INTERNAL_CLASS(LuauCompileBatch);
 
         WARN_PRINT("[LuauGDExtension] Initializing Extension");
         GDREGISTER_INTERNAL_CLASS(LuauScript);
@@ -59,6 +62,7 @@ void initialize_luau_module(ModuleInitializationLevel p_level) {
     if (p_level == MODULE_INITIALIZATION_LEVEL_EDITOR) {
         GDREGISTER_INTERNAL_CLASS(LuauPlugin);
         GDREGISTER_INTERNAL_CLASS(LuauSyntaxHighlighter);
+        GDREGISTER_INTERNAL_CLASS(LuauExportPlugin);
 
         EditorPlugins::add_by_type<LuauPlugin>();
         WARN_PRINT("[LuauGDExtension] Editor Plugin registered successfully");
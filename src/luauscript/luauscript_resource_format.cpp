@@ -39,6 +39,34 @@ String ResourceFormatLoaderLuau::_get_resource_type(const String &p_path) const
     return get_resource_type(p_path);
 }
 
+bool ResourceFormatLoaderLuau::_exists(const String &p_path) const {
+	// Exports may strip the source and ship only the precompiled bundle
+	return FileAccess::file_exists(p_path) || LuauCache::get_singleton()->has_bundled(p_path);
+}
+
+PackedStringArray ResourceFormatLoaderLuau::_get_dependencies(const String &p_path, bool p_add_types) const {
+	String path = p_path.simplify_path();
+	LuauCache *cache = LuauCache::get_singleton();
+
+	PackedStringArray dependencies = cache->get_dependencies(path);
+	if (dependencies.is_empty()) {
+		// Not analysed yet this session; analysis alone is enough to find the edges
+		Error err;
+		Ref<LuauScript> script = cache->get_script(path, err, false, LuauScript::LOAD_ANALYSIS);
+		if (script.is_valid()) {
+			dependencies = script->get_definition().dependencies;
+		}
+	}
+
+	if (p_add_types) {
+		for (int i = 0; i < dependencies.size(); i++) {
+			dependencies.set(i, dependencies[i] + "::" + luau::LUAUSCRIPT_TYPE);
+		}
+	}
+
+	return dependencies;
+}
+
 Variant ResourceFormatLoaderLuau::_load(const String &p_path, const String &p_original_path, bool p_use_sub_threads, int32_t p_cache_mode) const {
 	Error err;
 	bool ignoring = p_cache_mode == CACHE_MODE_IGNORE || p_cache_mode == CACHE_MODE_IGNORE_DEEP;
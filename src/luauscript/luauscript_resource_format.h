@@ -24,9 +24,9 @@ namespace godot {
         Variant _load(const String &p_path, const String &p_original_path, bool p_use_sub_threads, int32_t p_cache_mode) const override;
         // virtual String _get_resource_script_class(const String &p_path) const;
         // virtual int64_t _get_resource_uid(const String &p_path) const;
-        // virtual PackedStringArray _get_dependencies(const String &p_path, bool p_add_types) const;
+        PackedStringArray _get_dependencies(const String &p_path, bool p_add_types) const override;
         // virtual Error _rename_dependencies(const String &p_path, const Dictionary &p_renames) const;
-        // virtual bool _exists(const String &p_path) const;
+        bool _exists(const String &p_path) const override;
         // virtual PackedStringArray _get_classes_used(const String &p_path) const;
     };
 
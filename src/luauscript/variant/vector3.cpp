@@ -17,49 +17,49 @@ void Vector3Bridge::register_variant_class(lua_State* L) {
     luaL_register(L, variant_name, static_library);
 
     // CONSTANTS
-    Vector3Bridge::push_from(L, Vector3(0, 0, 0));
+    push_value(L, Vector3(0, 0, 0));
     lua_setfield(L, -2, "ZERO");
 
-    Vector3Bridge::push_from(L, Vector3(1, 1, 1));
+    push_value(L, Vector3(1, 1, 1));
     lua_setfield(L, -2, "ONE");
 
-    Vector3Bridge::push_from(L, Vector3(Math_INF, Math_INF, Math_INF));
+    push_value(L, Vector3(Math_INF, Math_INF, Math_INF));
     lua_setfield(L, -2, "INF");
 
-    Vector3Bridge::push_from(L, Vector3(-1, 0, 0));
+    push_value(L, Vector3(-1, 0, 0));
     lua_setfield(L, -2, "LEFT");
     
-    Vector3Bridge::push_from(L, Vector3(1, 0, 0));
+    push_value(L, Vector3(1, 0, 0));
     lua_setfield(L, -2, "RIGHT");
     
-    Vector3Bridge::push_from(L, Vector3(0, -1, 0));
+    push_value(L, Vector3(0, -1, 0));
     lua_setfield(L, -2, "DOWN");
     
-    Vector3Bridge::push_from(L, Vector3(0, 1, 0));
+    push_value(L, Vector3(0, 1, 0));
     lua_setfield(L, -2, "UP");
     
-    Vector3Bridge::push_from(L, Vector3(0, 0, -1));
+    push_value(L, Vector3(0, 0, -1));
     lua_setfield(L, -2, "FORWARD");
     
-    Vector3Bridge::push_from(L, Vector3(0, 0, 1));
+    push_value(L, Vector3(0, 0, 1));
     lua_setfield(L, -2, "BACK");
 
-    Vector3Bridge::push_from(L, Vector3(1, 0, 0));
+    push_value(L, Vector3(1, 0, 0));
     lua_setfield(L, -2, "MODEL_LEFT");
     
-    Vector3Bridge::push_from(L, Vector3(-1, 0, 0));
+    push_value(L, Vector3(-1, 0, 0));
     lua_setfield(L, -2, "MODEL_RIGHT");
     
-    Vector3Bridge::push_from(L, Vector3(0, 1, 0));
+    push_value(L, Vector3(0, 1, 0));
     lua_setfield(L, -2, "MODEL_TOP");
     
-    Vector3Bridge::push_from(L, Vector3(0, -1, 0));
+    push_value(L, Vector3(0, -1, 0));
     lua_setfield(L, -2, "MODEL_BOTTOM");
     
-    Vector3Bridge::push_from(L, Vector3(0, 0, 1));
+    push_value(L, Vector3(0, 0, 1));
     lua_setfield(L, -2, "MODEL_FRONT");
     
-    Vector3Bridge::push_from(L, Vector3(0, 0, -1));
+    push_value(L, Vector3(0, 0, -1));
     lua_setfield(L, -2, "MODEL_REAR");
 
 
@@ -69,6 +69,14 @@ void Vector3Bridge::register_variant_class(lua_State* L) {
     lua_pop(L, 1);
 }
 
+void Vector3Bridge::push_value(lua_State* L, const Vector3& p_value) {
+    if (LuauBridge::is_native_vectors()) {
+        lua_pushvector(L, p_value.x, p_value.y, p_value.z);
+    } else {
+        push_from(L, p_value);
+    }
+}
+
 int Vector3Bridge::octahedron_decode(lua_State* L) {
     Variant v = LuauBridge::get_variant(L, 1);
 
@@ -78,7 +86,7 @@ int Vector3Bridge::octahedron_decode(lua_State* L) {
     }
     
     Vector3 result = Vector3::octahedron_decode(v.operator Vector2());
-    push_from(L, result);
+    push_value(L, result);
 
     return 1;
 }
@@ -98,7 +106,7 @@ int VariantBridge<Vector3>::on_call(lua_State* L, bool& is_valid) {
     const int argc = lua_gettop(L)-1;
 
     if (argc == 0) {
-        push_new(L);
+        push_value(L, Vector3());
         return 1;
         
     } else if (argc == 1) {
@@ -106,11 +114,11 @@ int VariantBridge<Vector3>::on_call(lua_State* L, bool& is_valid) {
 
         switch(v.get_type()) {
             case Variant::VECTOR3: {
-                push_from(L, v.operator Vector3());
+                push_value(L, v.operator Vector3());
                 return 1;
             }
             case Variant::VECTOR3I: {
-                push_from(L, v.operator Vector3());
+                push_value(L, v.operator Vector3());
                 return 1;
             }
         };
@@ -124,7 +132,7 @@ int VariantBridge<Vector3>::on_call(lua_State* L, bool& is_valid) {
             && y.get_type() == Variant::FLOAT 
             && z.get_type() == Variant::FLOAT
         ) {
-            push_from(L, Vector3(x.operator float(), y.operator float(), z.operator float()));
+            push_value(L, Vector3(x.operator float(), y.operator float(), z.operator float()));
             return 1;
         }
 
@@ -132,4 +140,137 @@ int VariantBridge<Vector3>::on_call(lua_State* L, bool& is_valid) {
 
     is_valid = false;
     return 1;
-}
\ No newline at end of file
+}
+
+//MARK: Native vector
+static Vector3 check_vector(lua_State* L, int p_index) {
+    const float* v = luaL_checkvector(L, p_index);
+    return Vector3(v[0], v[1], v[2]);
+}
+
+const luaL_Reg Vector3Bridge::native_methods[] = {
+    {"length", native_length},
+    {"length_squared", native_length_squared},
+    {"normalized", native_normalized},
+    {"dot", native_dot},
+    {"cross", native_cross},
+    {"lerp", native_lerp},
+    {"distance_to", native_distance_to},
+    {"direction_to", native_direction_to},
+    {"is_zero_approx", native_is_zero_approx},
+    {"is_equal_approx", native_is_equal_approx},
+    {NULL, NULL}
+};
+
+void Vector3Bridge::register_native_vector(lua_State* L) {
+    // Builtin vectors share one metatable. x/y/z reads and arithmetic never reach
+    // it; only method calls do.
+    lua_pushvector(L, 0, 0, 0);
+    lua_newtable(L);
+
+    lua_newtable(L);
+    luaL_register(L, NULL, native_methods);
+    lua_setreadonly(L, -1, true);
+
+    lua_newtable(L); // Closures for the other builtin methods, filled on first use
+
+    lua_pushcclosure(L, native_index, "Vector3.__index", 2);
+    lua_setfield(L, -2, "__index");
+
+    lua_pushstring(L, variant_name);
+    lua_setfield(L, -2, "__type");
+
+    LuauBridge::protect_metatable(L, -1);
+    lua_setreadonly(L, -1, true);
+    lua_setmetatable(L, -2);
+    lua_pop(L, 1);
+}
+
+int Vector3Bridge::native_index(lua_State* L) {
+    const char* key = luaL_checkstring(L, 2);
+
+    // The listed methods, then closures cached by earlier lookups
+    for (int i = 1; i <= 2; i++) {
+        lua_pushvalue(L, 2);
+        lua_rawget(L, lua_upvalueindex(i));
+        if (!lua_isnil(L, -1)) {
+            return 1;
+        }
+        lua_pop(L, 1);
+    }
+
+    // Anything else goes through Variant, like the userdata representation
+    Variant object = check_vector(L, 1);
+    StringName name(key);
+
+    bool valid = false;
+    Variant value = object.get(name, &valid);
+    if (valid) {
+        LuauBridge::push_variant(L, value);
+        return 1;
+    }
+
+    if (!object.has_method(name)) {
+        luaL_error(L, "Invalid property: Vector3.%s", key);
+    }
+
+    // Same cached closure and ptrcall path as the userdata types, resolved once per VM
+    LuauBridge::MethodBinding *binding = push_method_name(L, name);
+    LuauBridge::resolve_builtin_method(Variant::VECTOR3, key, binding->builtin);
+    lua_pushcclosure(L, on_method_call, key, 1);
+
+    lua_pushvalue(L, 2);
+    lua_pushvalue(L, -2);
+    lua_rawset(L, lua_upvalueindex(2));
+    return 1;
+}
+
+int Vector3Bridge::native_length(lua_State* L) {
+    lua_pushnumber(L, check_vector(L, 1).length());
+    return 1;
+}
+
+int Vector3Bridge::native_length_squared(lua_State* L) {
+    lua_pushnumber(L, check_vector(L, 1).length_squared());
+    return 1;
+}
+
+int Vector3Bridge::native_normalized(lua_State* L) {
+    push_value(L, check_vector(L, 1).normalized());
+    return 1;
+}
+
+int Vector3Bridge::native_dot(lua_State* L) {
+    lua_pushnumber(L, check_vector(L, 1).dot(check_vector(L, 2)));
+    return 1;
+}
+
+int Vector3Bridge::native_cross(lua_State* L) {
+    push_value(L, check_vector(L, 1).cross(check_vector(L, 2)));
+    return 1;
+}
+
+int Vector3Bridge::native_lerp(lua_State* L) {
+    push_value(L, check_vector(L, 1).lerp(check_vector(L, 2), luaL_checknumber(L, 3)));
+    return 1;
+}
+
+int Vector3Bridge::native_distance_to(lua_State* L) {
+    lua_pushnumber(L, check_vector(L, 1).distance_to(check_vector(L, 2)));
+    return 1;
+}
+
+int Vector3Bridge::native_direction_to(lua_State* L) {
+    push_value(L, check_vector(L, 1).direction_to(check_vector(L, 2)));
+    return 1;
+}
+
+int Vector3Bridge::native_is_zero_approx(lua_State* L) {
+    lua_pushboolean(L, check_vector(L, 1).is_zero_approx());
+    return 1;
+}
+
+int Vector3Bridge::native_is_equal_approx(lua_State* L) {
+    lua_pushboolean(L, check_vector(L, 1).is_equal_approx(check_vector(L, 2)));
+    return 1;
+}
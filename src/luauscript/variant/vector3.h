@@ -12,9 +12,28 @@ class Vector3Bridge: public VariantBridge<Vector3> {
 
     public:
         static void register_variant_class(lua_State* L);
+
+        // Native vector mode: methods for Luau's builtin vector type, shared by all vectors.
+        static void register_native_vector(lua_State* L);
+
+        // Builtin vector or userdata, depending on LuauBridge::is_native_vectors().
+        static void push_value(lua_State* L, const Vector3& p_value);
     private:
         static const luaL_Reg static_library[];
+        static const luaL_Reg native_methods[];
         static int octahedron_decode(lua_State* L);
+
+        static int native_index(lua_State* L);
+        static int native_length(lua_State* L);
+        static int native_length_squared(lua_State* L);
+        static int native_normalized(lua_State* L);
+        static int native_dot(lua_State* L);
+        static int native_cross(lua_State* L);
+        static int native_lerp(lua_State* L);
+        static int native_distance_to(lua_State* L);
+        static int native_direction_to(lua_State* L);
+        static int native_is_zero_approx(lua_State* L);
+        static int native_is_equal_approx(lua_State* L);
 };
 
 };
@@ -7,15 +7,26 @@
 #include <godot_cpp/classes/os.hpp>
 #include <godot_cpp/classes/engine.hpp>
 #include <godot_cpp/classes/node.hpp>
+#include <godot_cpp/classes/canvas_item.hpp>
 #include <godot_cpp/classes/thread.hpp>
 #include <godot_cpp/classes/resource_loader.hpp>
 #include <godot_cpp/classes/scene_tree.hpp>
 #include <godot_cpp/classes/object.hpp>
 #include <godot_cpp/classes/window.hpp>
 #include <godot_cpp/classes/file_access.hpp>
+#include <godot_cpp/classes/dir_access.hpp>
+#include <godot_cpp/classes/worker_thread_pool.hpp>
+#include <godot_cpp/variant/callable_method_pointer.hpp>
+#include <godot_cpp/variant/utility_functions.hpp>
+
+#include <Luau/Compiler.h>
 
 #include "luauscript/luau_engine.h"
+#include "luauscript/luau_bridge.h"
 #include "luauscript/luau_script.h"
+#include "luauscript/luau_cache.h"
+#include "luauscript/luau_bundle.h"
+#include "luauscript/variant/builtin_types.h"
 
 using namespace godot;
 
@@ -57,4 +68,846 @@ TEST_CASE("Run sayhello.luau") {
     SceneTree* new_node = memnew(SceneTree);
     new_node->set_script(scr);
     root_scene->set_current_scene(nobind::Object::cast_to<Node>(new_node));
-}
\ No newline at end of file
+}
+
+TEST_CASE("Call threads are recycled") {
+    LuauEngine *engine = LuauEngine::get_singleton();
+    REQUIRE(engine != nullptr);
+
+    LuauEngine::PooledThread first = engine->acquire_thread(LuauEngine::VM_CORE);
+    CHECK(first.L != nullptr);
+    engine->release_thread(LuauEngine::VM_CORE, first);
+
+    uint64_t reused = engine->get_vm_stats(LuauEngine::VM_CORE).threads_reused;
+
+    LuauEngine::PooledThread second = engine->acquire_thread(LuauEngine::VM_CORE);
+    CHECK(second.L == first.L);
+    CHECK(engine->get_vm_stats(LuauEngine::VM_CORE).threads_reused == reused + 1);
+    engine->release_thread(LuauEngine::VM_CORE, second);
+}
+
+TEST_CASE("Script methods are flattened into the dispatch table") {
+    Ref<LuauScript> scr;
+    scr.instantiate();
+
+    REQUIRE(scr->load_source_code("res://luau_scripts/sayhello.luau") == OK);
+    REQUIRE(scr->load(LuauScript::LOAD_FULL) == OK);
+
+    const LuauScript::MethodDispatch *init = scr->get_dispatch("_init");
+    REQUIRE(init != nullptr);
+    CHECK(init->args_required == 0);
+    CHECK(init->args_allowed == 0);
+    CHECK(scr->get_dispatch("_process") == nullptr);
+}
+
+TEST_CASE("Scripts without _notification skip notifications") {
+    Ref<LuauScript> scr;
+    scr.instantiate();
+
+    REQUIRE(scr->load_source_code("res://luau_scripts/sayhello.luau") == OK);
+    REQUIRE(scr->load(LuauScript::LOAD_FULL) == OK);
+
+    CHECK_FALSE(scr->handles_notification(Node::NOTIFICATION_PROCESS));
+}
+
+TEST_CASE("@notifications names resolve through a script base") {
+    Ref<LuauScript> scr;
+    scr.instantiate();
+    scr->set_source_code("--- @extends res://luau_scripts/helloworld.luau\n--- @notifications NOTIFICATION_DRAW\nfunction _notification(what)\nend\n");
+    REQUIRE(scr->load(LuauScript::LOAD_FULL) == OK);
+
+    CHECK(scr->handles_notification(CanvasItem::NOTIFICATION_DRAW));
+    CHECK_FALSE(scr->handles_notification(Node::NOTIFICATION_PROCESS));
+}
+
+TEST_CASE("@notifications filters follow the inherited _notification") {
+    Ref<LuauScript> base;
+    base.instantiate();
+    base->take_over_path("res://notification_base.luau");
+    base->set_source_code("---@extends Node2D\n---@notifications NOTIFICATION_DRAW\nfunction _notification(what)\nend\n");
+    REQUIRE(base->load(LuauScript::LOAD_FULL) == OK);
+
+    // No filter of its own: the base's applies
+    Ref<LuauScript> plain;
+    plain.instantiate();
+    plain->set_source_code("---@extends res://notification_base.luau\nfunction own()\nend\n");
+    REQUIRE(plain->load(LuauScript::LOAD_FULL) == OK);
+    CHECK(plain->handles_notification(CanvasItem::NOTIFICATION_DRAW));
+    CHECK_FALSE(plain->handles_notification(Node::NOTIFICATION_PROCESS));
+
+    // A derived filter adds codes without dropping the ones the base handler needs
+    Ref<LuauScript> filtered;
+    filtered.instantiate();
+    filtered->set_source_code("---@extends res://notification_base.luau\n---@notifications NOTIFICATION_PROCESS\n");
+    REQUIRE(filtered->load(LuauScript::LOAD_FULL) == OK);
+    CHECK(filtered->handles_notification(CanvasItem::NOTIFICATION_DRAW));
+    CHECK(filtered->handles_notification(Node::NOTIFICATION_PROCESS));
+}
+
+TEST_CASE("Luau heap reuses small blocks") {
+    LuauAllocator allocator;
+
+    void *first = allocator.reallocate(nullptr, 0, 40);
+    REQUIRE(first != nullptr);
+    CHECK(allocator.get_stats().live_bytes == 40);
+
+    allocator.reallocate(first, 40, 0);
+    CHECK(allocator.get_stats().live_bytes == 0);
+
+    // Same size class, so the freed block comes back
+    void *second = allocator.reallocate(nullptr, 0, 48);
+    CHECK(second == first);
+    CHECK(allocator.get_stats().peak_bytes == 48);
+
+    void *large = allocator.reallocate(second, 48, LuauAllocator::MAX_SMALL_SIZE * 4);
+    REQUIRE(large != nullptr);
+    CHECK(allocator.get_stats().live_bytes == LuauAllocator::MAX_SMALL_SIZE * 4);
+    allocator.reallocate(large, LuauAllocator::MAX_SMALL_SIZE * 4, 0);
+
+    CHECK(allocator.get_stats().allocations == allocator.get_stats().frees);
+}
+
+TEST_CASE("Frame GC releases deferred refs") {
+    LuauEngine *engine = LuauEngine::get_singleton();
+    REQUIRE(engine != nullptr);
+
+    lua_State *L = engine->get_vm(LuauEngine::VM_USER);
+    lua_newtable(L);
+    int ref = lua_ref(L, -1);
+    lua_pop(L, 1);
+
+    uint64_t deferred = engine->get_vm_stats(LuauEngine::VM_USER).unrefs_deferred;
+
+    engine->queue_unref(LuauEngine::VM_USER, ref);
+    CHECK(engine->get_vm_stats(LuauEngine::VM_USER).unrefs_deferred == deferred + 1);
+
+    // Still referenced until the queue drains
+    lua_getref(L, ref);
+    CHECK(lua_istable(L, -1));
+    lua_pop(L, 1);
+
+    engine->step_gc(0);
+
+    // A released slot holds the registry free list link instead of the table
+    lua_getref(L, ref);
+    CHECK_FALSE(lua_istable(L, -1));
+    lua_pop(L, 1);
+}
+
+TEST_CASE("Luau heap refuses to grow past its limit") {
+    LuauAllocator allocator;
+    allocator.set_limit(1024);
+
+    // Outside a protected call nothing could catch LUA_ERRMEM, so the limit waits
+    void *outside = allocator.reallocate(nullptr, 0, 2048);
+    REQUIRE(outside != nullptr);
+    allocator.reallocate(outside, 2048, 0);
+
+    allocator.enter_protected();
+
+    void *block = allocator.reallocate(nullptr, 0, 512);
+    REQUIRE(block != nullptr);
+    CHECK(allocator.reallocate(nullptr, 0, 1024) == nullptr);
+    CHECK(allocator.get_stats().live_bytes == 512);
+
+    // Shrinking and freeing always succeed
+    block = allocator.reallocate(block, 512, 64);
+    CHECK(block != nullptr);
+    allocator.reallocate(block, 64, 0);
+    CHECK(allocator.get_stats().live_bytes == 0);
+}
+
+TEST_CASE("Deferred tasks resume on the next frame") {
+    LuauEngine *engine = LuauEngine::get_singleton();
+    REQUIRE(engine != nullptr);
+
+    lua_State *L = engine->get_vm(LuauEngine::VM_CORE);
+    uint32_t live = engine->get_task_count(LuauEngine::VM_CORE);
+
+    lua_getglobal(L, "task");
+    lua_getfield(L, -1, "defer");
+    lua_pushcfunction(L, [](lua_State *L) -> int { return 0; }, "noop");
+    REQUIRE(lua_pcall(L, 1, 1, 0) == LUA_OK);
+    CHECK(lua_isthread(L, -1));
+    lua_pop(L, 2); // thread, task table
+
+    CHECK(engine->get_task_count(LuauEngine::VM_CORE) == live + 1);
+    engine->resume_tasks();
+    CHECK(engine->get_task_count(LuauEngine::VM_CORE) == live);
+}
+
+TEST_CASE("Tasks finished by coroutine.resume are released") {
+    LuauEngine *engine = LuauEngine::get_singleton();
+    REQUIRE(engine != nullptr);
+
+    lua_State *L = engine->get_vm(LuauEngine::VM_CORE);
+    uint32_t live = engine->get_task_count(LuauEngine::VM_CORE);
+
+    const char *source =
+            "local parked = task.spawn(function() coroutine.yield() end)\n"
+            "coroutine.resume(parked)\n"
+            "local cancelled = true\n"
+            "task.spawn(function()\n"
+            "\tlocal outer = coroutine.running()\n"
+            "\tcancelled = coroutine.resume(coroutine.create(function() task.cancel(outer) end))\n"
+            "end)\n"
+            "return cancelled\n";
+
+    std::string bytecode = Luau::compile(source);
+    REQUIRE(luau_load(L, "=tasks", bytecode.data(), bytecode.size(), 0) == LUA_OK);
+    REQUIRE(lua_pcall(L, 0, 1, 0) == LUA_OK);
+
+    // Cancelling a task that is mid-resume is an error, not a reset of a live thread
+    CHECK_FALSE(lua_toboolean(L, -1));
+    lua_pop(L, 1);
+
+    // `parked` finished inside the script; coroutine.resume returned its thread to the pool
+    CHECK(engine->get_task_count(LuauEngine::VM_CORE) == live);
+}
+
+TEST_CASE("Freeing a node cancels its pending tasks") {
+    LuauEngine *engine = LuauEngine::get_singleton();
+    REQUIRE(engine != nullptr);
+
+    Ref<LuauScript> scr;
+    scr.instantiate();
+    scr->set_source_code("---@extends Node\nfunction start()\n\ttask.delay(0, function() set_name(\"late\") end)\nend\n");
+    REQUIRE(scr->load(LuauScript::LOAD_FULL) == OK);
+
+    Node *node = memnew(Node);
+    node->set_script(scr);
+
+    uint32_t live = engine->get_task_count(LuauEngine::VM_USER);
+    node->call("start");
+    CHECK(engine->get_task_count(LuauEngine::VM_USER) == live + 1);
+
+    memdelete(node);
+    CHECK(engine->get_task_count(LuauEngine::VM_USER) == live);
+
+    // The stale heap entry is skipped instead of resuming against the freed node
+    engine->resume_tasks();
+    CHECK(engine->get_task_count(LuauEngine::VM_USER) == live);
+}
+
+TEST_CASE("Bytecode cache keys follow the source") {
+    String a = LuauCache::get_cache_key("print('a')");
+    CHECK(a == LuauCache::get_cache_key("print('a')"));
+    CHECK(a != LuauCache::get_cache_key("print('b')"));
+
+    // A second script with the same source is restored rather than recompiled
+    Ref<LuauScript> first;
+    first.instantiate();
+    REQUIRE(first->load_source_code("res://luau_scripts/sayhello.luau") == OK);
+    REQUIRE(first->load(LuauScript::LOAD_ANALYSIS) == OK);
+
+    Ref<LuauScript> second;
+    second.instantiate();
+    REQUIRE(second->load_source_code("res://luau_scripts/sayhello.luau") == OK);
+    CHECK(LuauCache::get_singleton()->restore(LuauCache::get_cache_key(second->_get_source_code()), second.ptr()));
+    CHECK(second->get_definition().methods.has("_init"));
+}
+
+TEST_CASE("Editing a script drops its stale cache entry") {
+    Ref<LuauScript> scr;
+    scr.instantiate();
+    scr->take_over_path("res://stale_cache_entry.luau");
+    scr->set_source_code("local version = 1\n");
+    REQUIRE(scr->load(LuauScript::LOAD_ANALYSIS) == OK);
+
+    String old_key = LuauCache::get_cache_key("local version = 1\n");
+    CHECK(!LuauCache::get_singleton()->get_compiled_data(old_key).is_empty());
+
+    scr->set_source_code("local version = 2\n");
+    REQUIRE(scr->load(LuauScript::LOAD_ANALYSIS, true) == OK);
+    CHECK(LuauCache::get_singleton()->get_compiled_data(old_key).is_empty());
+}
+
+TEST_CASE("Batch compile publishes scripts") {
+    PackedStringArray paths;
+    paths.push_back("res://luau_scripts/sayhello.luau");
+
+    REQUIRE(LuauCache::get_singleton()->compile_batch(paths, true, LuauScript::LOAD_ANALYSIS) == OK);
+
+    Error err;
+    Ref<LuauScript> script = LuauCache::get_singleton()->get_script("res://luau_scripts/sayhello.luau", err, false, LuauScript::LOAD_ANALYSIS);
+    REQUIRE(err == OK);
+    CHECK(script->get_definition().methods.has("_init"));
+}
+
+TEST_CASE("Batch compile leaves loaded scripts alone") {
+    LuauCache *cache = LuauCache::get_singleton();
+
+    Error err;
+    Ref<LuauScript> held = cache->get_script("res://luau_scripts/sayhello.luau", err, false, LuauScript::LOAD_ANALYSIS);
+    REQUIRE(err == OK);
+
+    PackedStringArray paths;
+    paths.push_back("res://luau_scripts/sayhello.luau");
+
+    // Already loaded far enough, so nothing is recompiled or reloaded
+    uint64_t misses = cache->get_stats()["script_misses"];
+    uint64_t compiles = cache->get_stats()["compiles"];
+    REQUIRE(cache->compile_batch(paths, true, LuauScript::LOAD_ANALYSIS) == OK);
+    CHECK(uint64_t(cache->get_stats()["script_misses"]) == misses);
+    CHECK(uint64_t(cache->get_stats()["compiles"]) == compiles);
+    CHECK(cache->get_script("res://luau_scripts/sayhello.luau", err, false, LuauScript::LOAD_ANALYSIS) == held);
+}
+
+TEST_CASE("Header annotations come from the comment stream") {
+    LuauScript::CompiledScript result;
+    result.path = "res://annotated.luau";
+    result.source = "--!strict\n--- @class Annotated\n---@extends Node\n--[[ @tool ]]\nlocal x = 1\n-- @tool\n";
+
+    REQUIRE(LuauScript::compile_source(result) == OK);
+    CHECK(!result.bytecode.is_empty());
+    CHECK(result.definition.name == "Annotated");
+    CHECK(result.definition.extends == "Node");
+    // Block comments and comments after the first statement are not annotations
+    CHECK(!result.definition.is_tool);
+}
+
+TEST_CASE("Lean loading skips inspector hints") {
+    LuauScript::CompiledScript full;
+    full.path = "res://lean.luau";
+    full.source = "Target = nil :: Node\n";
+
+    LuauScript::CompiledScript lean = full;
+    lean.lean = true;
+
+    REQUIRE(LuauScript::compile_source(full) == OK);
+    REQUIRE(LuauScript::compile_source(lean) == OK);
+
+    // Both keep the property itself, only the hint differs
+    REQUIRE(lean.definition.property_indices.has("Target"));
+    CHECK(full.definition.properties[0].property.hint == PROPERTY_HINT_NODE_TYPE);
+    CHECK(lean.definition.properties[0].property.hint == PROPERTY_HINT_NONE);
+    CHECK(lean.bytecode == full.bytecode);
+
+    // Cached lean results must not satisfy a full load
+    CHECK(LuauCache::get_cache_key(full.source, "debug", false) != LuauCache::get_cache_key(full.source, "debug", true));
+}
+
+TEST_CASE("Compile profiles change bytecode and cache keys") {
+    String source = "local function add(a, b) return a + b end\nreturn add(1, 2)\n";
+    CHECK(LuauCache::get_cache_key(source, "debug", false) != LuauCache::get_cache_key(source, "release", false));
+
+    LuauScript::CompiledScript debug;
+    debug.source = source;
+    debug.profile = "debug";
+
+    LuauScript::CompiledScript release = debug;
+    release.profile = "release";
+
+    // The hot comment wins over the requested profile
+    LuauScript::CompiledScript overridden = debug;
+    overridden.source = "--!profile release\n" + source;
+
+    REQUIRE(LuauScript::compile_source(debug) == OK);
+    REQUIRE(LuauScript::compile_source(release) == OK);
+    REQUIRE(LuauScript::compile_source(overridden) == OK);
+
+    // Release drops local and upvalue debug info
+    CHECK(release.bytecode.size() < debug.bytecode.size());
+    CHECK(overridden.bytecode.size() < debug.bytecode.size());
+}
+
+TEST_CASE("Script bundles round-trip through one file") {
+    Dictionary entry;
+    entry["bytecode"] = PackedByteArray({ 1, 2, 3 });
+
+    PackedStringArray paths;
+    paths.push_back("res://a.luau");
+    paths.push_back("res://dir/b.luau");
+
+    Vector<PackedByteArray> blobs;
+    blobs.push_back(UtilityFunctions::var_to_bytes(entry));
+    blobs.push_back(UtilityFunctions::var_to_bytes(Dictionary()));
+
+    String path = "user://test_bundle.lubn";
+    Ref<FileAccess> file = FileAccess::open(path, FileAccess::WRITE);
+    REQUIRE(file.is_valid());
+    file->store_buffer(LuauBundle::pack(paths, blobs, true));
+    file->close();
+
+    LuauBundle bundle;
+    REQUIRE(bundle.open(path));
+    CHECK(bundle.has("res://dir/b.luau"));
+    CHECK(!bundle.has("res://c.luau"));
+    CHECK(PackedByteArray(bundle.get("res://a.luau")["bytecode"]) == PackedByteArray({ 1, 2, 3 }));
+    CHECK(bundle.get("res://dir/b.luau").is_empty());
+}
+
+static Ref<LuauScript> concurrent_results[8];
+
+static void load_concurrently(uint32_t p_index) {
+    Error err;
+    concurrent_results[p_index] = LuauCache::get_singleton()->get_script("res://luau_scripts/helloworld.luau", err, false, LuauScript::LOAD_ANALYSIS);
+}
+
+TEST_CASE("Concurrent loads share one script") {
+    WorkerThreadPool *pool = WorkerThreadPool::get_singleton();
+    int64_t group = pool->add_group_task(callable_mp_static(&load_concurrently), 8);
+    pool->wait_for_group_task_completion(group);
+
+    REQUIRE(concurrent_results[0].is_valid());
+    for (int i = 1; i < 8; i++) {
+        CHECK(concurrent_results[i] == concurrent_results[0]);
+    }
+    CHECK(concurrent_results[0]->get_definition().name == "helloworld");
+
+    for (Ref<LuauScript> &script : concurrent_results) {
+        script.unref();
+    }
+}
+
+static const char *cycle_paths[2] = { "res://cycle_a.luau", "res://cycle_b.luau" };
+static Ref<LuauScript> cycle_results[2];
+
+static void load_cycle(uint32_t p_index) {
+    Error err;
+    cycle_results[p_index] = LuauCache::get_singleton()->get_script(cycle_paths[p_index], err, false, LuauScript::LOAD_FULL);
+}
+
+TEST_CASE("Threads loading scripts that need each other don't deadlock") {
+    // Each extends the other, so each thread's load waits for the other's when they overlap
+    for (int i = 0; i < 2; i++) {
+        Ref<FileAccess> file = FileAccess::open(cycle_paths[i], FileAccess::WRITE);
+        REQUIRE(file.is_valid());
+        file->store_string(vformat("---@extends %s\n", cycle_paths[1 - i]));
+        file->close();
+    }
+
+    WorkerThreadPool *pool = WorkerThreadPool::get_singleton();
+    int64_t group = pool->add_group_task(callable_mp_static(&load_cycle), 2);
+    pool->wait_for_group_task_completion(group);
+
+    CHECK(cycle_results[0].is_valid());
+    CHECK(cycle_results[1].is_valid());
+
+    for (int i = 0; i < 2; i++) {
+        cycle_results[i].unref();
+        DirAccess::remove_absolute(cycle_paths[i]);
+    }
+}
+
+TEST_CASE("Unused scripts are evicted least recently used first") {
+    LuauCache *cache = LuauCache::get_singleton();
+
+    PackedStringArray paths;
+    paths.push_back("res://luau_scripts/sayhello.luau");
+    paths.push_back("res://luau_scripts/helloworld.luau");
+    REQUIRE(cache->preload(paths) == OK);
+
+    Error err;
+    Ref<LuauScript> held = cache->get_script("res://luau_scripts/helloworld.luau", err);
+    uint64_t hits = cache->get_stats()["script_hits"];
+    CHECK(hits > 0);
+
+    uint64_t evictions = cache->get_stats()["evictions"];
+    cache->set_limits(1, 0);
+    cache->trim();
+    cache->set_limits(0, 0);
+
+    CHECK(uint64_t(cache->get_stats()["evictions"]) > evictions);
+    // A script that is still referenced is never dropped
+    CHECK(cache->get_scripts().has(held));
+}
+
+TEST_CASE("Reloads follow the dependency graph") {
+    LuauScript::CompiledScript result;
+    result.path = "res://dep_child.luau";
+    result.source = "--- @extends res://dep_base.luau\nlocal helper = require(\"res://dep_helper.luau\")\nlocal icon = \"res://icon.png\"\n";
+
+    REQUIRE(LuauScript::compile_source(result) == OK);
+    CHECK(result.definition.dependencies.size() == 2);
+    CHECK(result.definition.dependencies.has("res://dep_base.luau"));
+    CHECK(result.definition.dependencies.has("res://dep_helper.luau"));
+
+    LuauCache *cache = LuauCache::get_singleton();
+    cache->update_dependencies("res://dep_child.luau", result.definition.dependencies);
+    cache->update_dependencies("res://dep_grandchild.luau", PackedStringArray({ "res://dep_child.luau" }));
+
+    // Saving the base reloads it, then the child, then the grandchild; the helper is untouched
+    PackedStringArray order = cache->get_reload_order(PackedStringArray({ "res://dep_base.luau" }));
+    REQUIRE(order.size() == 3);
+    CHECK(order[0] == "res://dep_base.luau");
+    CHECK(order[1] == "res://dep_child.luau");
+    CHECK(order[2] == "res://dep_grandchild.luau");
+}
+
+#ifdef TOOLS_ENABLED
+TEST_CASE("Hot reload patches functions and keeps instance state") {
+    Ref<LuauScript> scr;
+    scr.instantiate();
+    scr->set_source_code("---@extends Node\nlocal calls = 0\ncount = 0\nlocal function step()\n\treturn 1\nend\nfunction bump()\n\tcalls += step()\n\treturn calls\nend\n");
+    REQUIRE(scr->load(LuauScript::LOAD_FULL) == OK);
+
+    Node *node = memnew(Node);
+    node->set_script(scr);
+    node->set("count", 5);
+    CHECK(int(node->call("bump")) == 1);
+
+    // Same-named upvalues and fields survive; function bodies, local helpers included, change
+    scr->set_source_code("---@extends Node\nlocal calls = 0\ncount = 0\nlabel = \"new\"\nlocal function step()\n\tcount += 1\n\treturn count\nend\nfunction bump()\n\tcalls += step()\n\treturn calls\nend\n");
+    REQUIRE(scr->reload(true) == OK);
+
+    // The new helper writes to the instance, not to the chunk's shadow environment
+    CHECK(int(node->call("bump")) == 7);
+    CHECK(int(node->get("count")) == 6);
+    CHECK(String(node->get("label")) == "new");
+
+    memdelete(node);
+}
+#endif // TOOLS_ENABLED
+
+TEST_CASE("Derived dispatch follows a reloaded base") {
+    Ref<LuauScript> base;
+    base.instantiate();
+    base->take_over_path("res://dispatch_base.luau");
+    base->set_source_code("---@extends Node\nfunction greet()\n\treturn 1\nend\n");
+    REQUIRE(base->load(LuauScript::LOAD_FULL) == OK);
+
+    Ref<LuauScript> derived;
+    derived.instantiate();
+    derived->set_source_code("---@extends res://dispatch_base.luau\nfunction own()\n\treturn 0\nend\n");
+    REQUIRE(derived->load(LuauScript::LOAD_FULL) == OK);
+    CHECK(derived->get_dispatch("greet") != nullptr);
+    CHECK(derived->get_dispatch("wave") == nullptr);
+
+    base->set_source_code("---@extends Node\nfunction greet()\n\treturn 1\nend\nfunction wave()\n\treturn 2\nend\n");
+    REQUIRE(base->load(LuauScript::LOAD_FULL, true) == OK);
+
+    derived->update_dispatch();
+    CHECK(derived->get_dispatch("wave") != nullptr);
+    CHECK(derived->get_dispatch("own") != nullptr);
+}
+
+TEST_CASE("Engine calls keep the method captured at creation") {
+    Ref<LuauScript> scr;
+    scr.instantiate();
+    scr->set_source_code("---@extends Node\nfunction value()\n\treturn 1\nend\nfunction swap()\n\tvalue = function() return 2 end\nend\n");
+    REQUIRE(scr->load(LuauScript::LOAD_FULL) == OK);
+
+    Node *node = memnew(Node);
+    node->set_script(scr);
+
+    // Documented restriction: reassigning a method on self is invisible to engine calls
+    node->call("swap");
+    CHECK(int(node->call("value")) == 1);
+
+    memdelete(node);
+}
+
+TEST_CASE("Bridged userdata carries its Variant type as a tag") {
+    LuauEngine *engine = LuauEngine::get_singleton();
+    REQUIRE(engine != nullptr);
+
+    lua_State *L = engine->get_vm(LuauEngine::VM_CORE);
+    int top = lua_gettop(L);
+
+    LuauBridge::push_variant(L, Vector2(1, 2));
+    CHECK(lua_userdatatag(L, -1) == Variant::VECTOR2);
+    CHECK(LuauBridge::get_variant(L, -1) == Variant(Vector2(1, 2)));
+
+    LuauBridge::push_variant(L, Callable());
+    CHECK(lua_userdatatag(L, -1) == Variant::CALLABLE);
+    CHECK(LuauBridge::get_variant(L, -1).get_type() == Variant::CALLABLE);
+
+    lua_getglobal(L, "typeof");
+    lua_pushvalue(L, -3);
+    REQUIRE(lua_pcall(L, 1, 1, 0) == LUA_OK);
+    CHECK(String(lua_tostring(L, -1)) == "Vector2");
+
+    lua_settop(L, top);
+}
+
+TEST_CASE("Native vectors convert without userdata") {
+    LuauEngine *engine = LuauEngine::get_singleton();
+    REQUIRE(engine != nullptr);
+
+    lua_State *L = engine->get_vm(LuauEngine::VM_CORE);
+    lua_pushvector(L, 1, 2, 3);
+    CHECK(LuauBridge::get_variant(L, -1) == Variant(Vector3(1, 2, 3)));
+    lua_pop(L, 1);
+
+    // The mode changes the bytecode, so it is part of the cache key
+    bool native = LuauBridge::is_native_vectors();
+    String key = LuauCache::get_cache_key("local v = Vector3(1, 2, 3)");
+    LuauBridge::set_native_vectors(!native);
+    CHECK(key != LuauCache::get_cache_key("local v = Vector3(1, 2, 3)"));
+    LuauBridge::set_native_vectors(native);
+}
+
+TEST_CASE("Native vector scripts call methods without Variant round trips") {
+    LuauEngine *engine = LuauEngine::get_singleton();
+    REQUIRE(engine != nullptr);
+
+    lua_State *L = engine->get_vm(LuauEngine::VM_CORE);
+    int top = lua_gettop(L);
+
+    // VMs only get the vector metatable when created in this mode; it stays, but only
+    // native-mode bytecode produces vectors
+    bool native = LuauBridge::is_native_vectors();
+    LuauBridge::set_native_vectors(true);
+    Vector3Bridge::register_native_vector(L);
+
+    const char *source =
+            "local v = Vector3(1, 2, 3)\n"
+            "return type(v), v.normalized, v.abs == v.abs, v:lerp(Vector3(3, 2, 1), 0.5), v:abs()\n";
+
+    std::string bytecode = Luau::compile(source, LuauScript::get_compile_options("debug"));
+    LuauBridge::set_native_vectors(native);
+
+    REQUIRE(luau_load(L, "=native_vectors", bytecode.data(), bytecode.size(), 0) == LUA_OK);
+    REQUIRE(lua_pcall(L, 0, 5, 0) == LUA_OK);
+
+    // The constructor compiled to a builtin vector
+    CHECK(String(lua_tostring(L, top + 1)) == "vector");
+
+    // Listed methods are plain C functions from native_methods
+    REQUIRE(lua_iscfunction(L, top + 2));
+    CHECK(lua_getupvalue(L, top + 2, 1) == nullptr);
+
+    // Other builtin methods resolve once into a cached closure
+    CHECK(lua_toboolean(L, top + 3));
+
+    CHECK(lua_isvector(L, top + 4));
+    CHECK(LuauBridge::get_variant(L, top + 4) == Variant(Vector3(2, 2, 2)));
+    CHECK(LuauBridge::get_variant(L, top + 5) == Variant(Vector3(1, 2, 3)));
+
+    lua_settop(L, top);
+}
+
+// Runs the userdata operand's metamethod for p_event directly, as the VM does for
+// `a <op> b`. False when neither operand is userdata, e.g. native vectors and numbers,
+// which the VM computes itself.
+static bool call_bridge_operator(lua_State *L, const char *p_event, const Variant &p_a, const Variant &p_b, Variant *r_result = nullptr) {
+    LuauBridge::push_variant(L, p_a);
+    LuauBridge::push_variant(L, p_b);
+
+    int owner = lua_type(L, -2) == LUA_TUSERDATA ? -2 : (lua_type(L, -1) == LUA_TUSERDATA ? -1 : 0);
+    if (owner == 0) {
+        lua_pop(L, 2);
+        return false;
+    }
+
+    lua_getmetatable(L, owner);
+    lua_getfield(L, -1, p_event);
+    lua_remove(L, -2);
+    lua_insert(L, -3);
+    lua_call(L, 2, 1);
+
+    if (r_result) {
+        *r_result = LuauBridge::get_variant(L, -1);
+    }
+    lua_pop(L, 1);
+    return true;
+}
+
+struct BridgeOperatorPair {
+    const char *event;
+    Variant::Operator op;
+    Variant a;
+    Variant b;
+};
+
+static Vector<BridgeOperatorPair> get_bridge_operator_pairs() {
+    Basis basis(Vector3(0, 1, 0), 0.5);
+
+    return Vector<BridgeOperatorPair>({
+        { "__add", Variant::OP_ADD, Vector2(1, 2), Vector2(3, 4) },
+        { "__sub", Variant::OP_SUBTRACT, Vector3(1, 2, 3), Vector3(0.5, 0.5, 0.5) },
+        { "__mul", Variant::OP_MULTIPLY, Vector3(1, 2, 3), 2.5 },
+        { "__mul", Variant::OP_MULTIPLY, 2.5, Vector3(1, 2, 3) },
+        { "__div", Variant::OP_DIVIDE, Vector4(1, 2, 3, 4), 2.0 },
+        { "__mul", Variant::OP_MULTIPLY, Color(0.5, 0.25, 1), 0.5 },
+        { "__mul", Variant::OP_MULTIPLY, basis, Vector3(1, 0, 0) },
+        { "__mul", Variant::OP_MULTIPLY, basis, basis },
+        { "__mul", Variant::OP_MULTIPLY, Transform3D(basis, Vector3(1, 2, 3)), Vector3(1, 1, 1) },
+        { "__mul", Variant::OP_MULTIPLY, Transform2D(0.5, Vector2(1, 2)), Vector2(1, 1) },
+        { "__mul", Variant::OP_MULTIPLY, Quaternion(basis), Vector3(0, 0, 1) },
+        { "__eq", Variant::OP_EQUAL, Vector3(1, 2, 3), Vector3(1, 2, 3) },
+        // Integer vectors always take the Variant path
+        { "__add", Variant::OP_ADD, Vector2i(1, 2), Vector2i(3, 4) },
+    });
+}
+
+TEST_CASE("Bridge operators match Variant::evaluate") {
+    LuauEngine *engine = LuauEngine::get_singleton();
+    REQUIRE(engine != nullptr);
+
+    lua_State *L = engine->get_vm(LuauEngine::VM_CORE);
+
+    for (const BridgeOperatorPair &pair : get_bridge_operator_pairs()) {
+        Variant expected;
+        bool valid = false;
+        Variant::evaluate(pair.op, pair.a, pair.b, expected, valid);
+        REQUIRE(valid);
+
+        Variant result;
+        if (call_bridge_operator(L, pair.event, pair.a, pair.b, &result)) {
+            CHECK(result == expected);
+        }
+    }
+}
+
+// Runs the typed path alone, on a fresh thread since it reads its operands from slots 1 and 2.
+// True if it handled the pair; the result is checked against Variant::evaluate.
+template <Variant::Operator OP, class GDV>
+static bool run_fast_operator(lua_State *L, const Variant &p_a, const Variant &p_b) {
+    lua_State *T = lua_newthread(L);
+    LuauBridge::push_variant(T, p_a);
+    LuauBridge::push_variant(T, p_b);
+
+    bool handled = bridge_fast_operator<OP, GDV>(T);
+    if (handled) {
+        Variant expected;
+        bool valid = false;
+        Variant::evaluate(OP, p_a, p_b, expected, valid);
+        CHECK(LuauBridge::get_variant(T, -1) == expected);
+    }
+
+    lua_pop(L, 1);
+    return handled;
+}
+
+TEST_CASE("Float math types take the typed operator path") {
+    LuauEngine *engine = LuauEngine::get_singleton();
+    REQUIRE(engine != nullptr);
+
+    lua_State *L = engine->get_vm(LuauEngine::VM_CORE);
+    Basis basis(Vector3(0, 1, 0), 0.5);
+
+    CHECK(run_fast_operator<Variant::OP_ADD, Vector2>(L, Vector2(1, 2), Vector2(3, 4)));
+    CHECK(run_fast_operator<Variant::OP_SUBTRACT, Vector3>(L, Vector3(1, 2, 3), Vector3(0.5, 0.5, 0.5)));
+    CHECK(run_fast_operator<Variant::OP_MULTIPLY, Vector3>(L, Vector3(1, 2, 3), 2.5));
+    CHECK(run_fast_operator<Variant::OP_MULTIPLY, Vector3>(L, 2.5, Vector3(1, 2, 3)));
+    CHECK(run_fast_operator<Variant::OP_DIVIDE, Vector4>(L, Vector4(1, 2, 3, 4), 2.0));
+    CHECK(run_fast_operator<Variant::OP_MULTIPLY, Color>(L, Color(0.5, 0.25, 1), 0.5));
+    CHECK(run_fast_operator<Variant::OP_MULTIPLY, Basis>(L, basis, Vector3(1, 0, 0)));
+    CHECK(run_fast_operator<Variant::OP_MULTIPLY, Basis>(L, basis, basis));
+    CHECK(run_fast_operator<Variant::OP_MULTIPLY, Transform3D>(L, Transform3D(basis, Vector3(1, 2, 3)), Vector3(1, 1, 1)));
+    CHECK(run_fast_operator<Variant::OP_MULTIPLY, Transform2D>(L, Transform2D(0.5, Vector2(1, 2)), Vector2(1, 1)));
+    CHECK(run_fast_operator<Variant::OP_MULTIPLY, Quaternion>(L, Quaternion(basis), Vector3(0, 0, 1)));
+    CHECK(run_fast_operator<Variant::OP_EQUAL, Vector3>(L, Vector3(1, 2, 3), Vector3(1, 2, 3)));
+
+    // Integer vectors are left to Variant::evaluate
+    CHECK_FALSE(run_fast_operator<Variant::OP_ADD, Vector2i>(L, Vector2i(1, 2), Vector2i(3, 4)));
+}
+
+TEST_CASE("[bench] Bridge operators" * doctest::skip()) {
+    LuauEngine *engine = LuauEngine::get_singleton();
+    REQUIRE(engine != nullptr);
+
+    lua_State *L = engine->get_vm(LuauEngine::VM_CORE);
+    const int iterations = 10000;
+
+    for (const BridgeOperatorPair &pair : get_bridge_operator_pairs()) {
+        if (!call_bridge_operator(L, pair.event, pair.a, pair.b)) {
+            continue;
+        }
+
+        uint64_t start = nobind::Time::get_singleton()->get_ticks_usec();
+        for (int i = 0; i < iterations; i++) {
+            call_bridge_operator(L, pair.event, pair.a, pair.b);
+        }
+        uint64_t elapsed = nobind::Time::get_singleton()->get_ticks_usec() - start;
+
+        MESSAGE(vformat("%s %s %s: %.1f ns/op", Variant::get_type_name(pair.a.get_type()), pair.event,
+                Variant::get_type_name(pair.b.get_type()), elapsed * 1000.0 / iterations).utf8().get_data());
+    }
+}
+
+TEST_CASE("Value type fields are read and written through atoms") {
+    CHECK(LuauBridge::user_atom("x", 1) == LuauBridge::ATOM_X);
+    CHECK(LuauBridge::user_atom("origin", 6) == LuauBridge::ATOM_ORIGIN);
+    CHECK(LuauBridge::user_atom("length", 6) == -1);
+
+    LuauEngine *engine = LuauEngine::get_singleton();
+    REQUIRE(engine != nullptr);
+
+    lua_State *L = engine->get_vm(LuauEngine::VM_CORE);
+
+    LuauBridge::push_variant(L, Vector2(1, 2));
+    lua_getfield(L, -1, "y");
+    CHECK(lua_tonumber(L, -1) == 2);
+    lua_pop(L, 1);
+
+    // Writes land in the userdata itself
+    lua_pushnumber(L, 5);
+    lua_setfield(L, -2, "x");
+    CHECK(LuauBridge::get_variant(L, -1) == Variant(Vector2(5, 2)));
+    lua_pop(L, 1);
+
+    LuauBridge::push_variant(L, Transform3D(Basis(), Vector3(1, 2, 3)));
+    lua_getfield(L, -1, "origin");
+    CHECK(LuauBridge::get_variant(L, -1) == Variant(Vector3(1, 2, 3)));
+    lua_pop(L, 2);
+}
+
+TEST_CASE("Builtin methods resolve once into cached closures") {
+    LuauEngine *engine = LuauEngine::get_singleton();
+    REQUIRE(engine != nullptr);
+
+    lua_State *L = engine->get_vm(LuauEngine::VM_CORE);
+
+    LuauBridge::push_variant(L, Vector2(3, 4));
+    lua_getfield(L, -1, "length");
+    REQUIRE(lua_isfunction(L, -1));
+
+    // A second vector gets the very same closure
+    LuauBridge::push_variant(L, Vector2(1, 0));
+    lua_getfield(L, -1, "length");
+    CHECK(lua_rawequal(L, -1, -3));
+    lua_pop(L, 2);
+
+    lua_pushvalue(L, -2);
+    lua_call(L, 1, 1);
+    CHECK(lua_tonumber(L, -1) == doctest::Approx(5.0));
+    lua_pop(L, 2);
+
+    LuauBridge::push_variant(L, Vector2(1, 0));
+    lua_getfield(L, -1, "lerp");
+    lua_insert(L, -2);
+    LuauBridge::push_variant(L, Vector2(3, 0));
+    lua_pushnumber(L, 0.5);
+    lua_call(L, 3, 1);
+    CHECK(LuauBridge::get_variant(L, -1) == Variant(Vector2(2, 0)));
+    lua_pop(L, 1);
+}
+
+TEST_CASE("Builtin methods with plain signatures resolve to ptrcalls") {
+    LuauBridge::BuiltinMethod lerp;
+    LuauBridge::resolve_builtin_method(Variant::VECTOR2, "lerp", lerp);
+    CHECK(lerp.call != nullptr);
+    CHECK(lerp.arg_count == 2);
+    CHECK(lerp.return_type == Variant::VECTOR2);
+
+    // Object results only exist as Variants, so these stay on callp
+    LuauBridge::BuiltinMethod get_object;
+    LuauBridge::resolve_builtin_method(Variant::CALLABLE, "get_object", get_object);
+    CHECK(get_object.call == nullptr);
+}
+
+TEST_CASE("Dictionary keys shadow cached builtin methods") {
+    LuauEngine *engine = LuauEngine::get_singleton();
+    REQUIRE(engine != nullptr);
+
+    lua_State *L = engine->get_vm(LuauEngine::VM_CORE);
+
+    // Dictionary userdata (push_variant() converts to a table); resolve and cache `size` first
+    DictionaryBridge::push_from(L, Dictionary());
+    lua_getfield(L, -1, "size");
+    REQUIRE(lua_isfunction(L, -1));
+    lua_insert(L, -2);
+    lua_call(L, 1, 1);
+    CHECK(lua_tonumber(L, -1) == 0);
+    lua_pop(L, 1);
+
+    Dictionary dict;
+    dict["size"] = 3;
+    DictionaryBridge::push_from(L, dict);
+    lua_getfield(L, -1, "size");
+    CHECK(lua_tonumber(L, -1) == 3);
+    lua_pop(L, 2);
+}